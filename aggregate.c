@@ -0,0 +1,140 @@
+/**
+ * @file aggregate.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the hash aggregation engine.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for string manipulation (e.g., strcpy, strlen)
+
+#include "aggregate.h"
+#include "store.h"
+#include "symbols.h"
+
+/**
+ * @brief Hash of a group key.
+ */
+static unsigned int hashKey(Symbol location, int type, int priority) {
+    unsigned int hash = (unsigned int) location * 2654435761u;
+    hash ^= (unsigned int) (type + 1) * 40503u;
+    hash ^= (unsigned int) (priority + 1) * 2246822519u;
+    return hash ^ (hash >> 15);
+}
+
+/**
+ * @brief Finds the table position of a key (either its group or the empty slot where it belongs).
+ */
+static int probe(const Aggregation* aggregation, Symbol location, int type, int priority) {
+    unsigned int mask = (unsigned int) aggregation->tableSize - 1;
+    unsigned int pos = hashKey(location, type, priority) & mask;
+    while (aggregation->table[pos] >= 0) {
+        const GroupCount* group = &aggregation->groups[aggregation->table[pos]];
+        if (group->location == location && group->type == type && group->priority == priority) break;
+        pos = (pos + 1) & mask;
+    }
+    return (int) pos;
+}
+
+/**
+ * @brief Doubles the hash table and reinserts every group.
+ */
+static int growTable(Aggregation* aggregation) {
+    int newSize = aggregation->tableSize ? aggregation->tableSize * 2 : 64;
+    int* newTable = (int*) malloc(sizeof(int) * newSize);
+    int i;
+    if (!newTable) return 0;
+
+    for (i = 0; i < newSize; i++) newTable[i] = -1;
+    free(aggregation->table);
+    aggregation->table = newTable;
+    aggregation->tableSize = newSize;
+    for (i = 0; i < aggregation->count; i++) {
+        const GroupCount* group = &aggregation->groups[i];
+        aggregation->table[probe(aggregation, group->location, group->type, group->priority)] = i;
+    }
+    return 1;
+}
+
+/**
+ * @brief Initializes an empty aggregation.
+ */
+void aggregationInit(Aggregation* aggregation) {
+    memset(aggregation, 0, sizeof(Aggregation));
+}
+
+/**
+ * @brief Adds an amount to the group with the given keys.
+ */
+int aggregationAdd(Aggregation* aggregation, Symbol location, int type, int priority, int amount) {
+    int pos;
+    GroupCount* group;
+
+    if ((aggregation->count + 1) * 2 > aggregation->tableSize && !growTable(aggregation)) return 0;
+
+    pos = probe(aggregation, location, type, priority);
+    if (aggregation->table[pos] >= 0) {
+        aggregation->groups[aggregation->table[pos]].count += amount;
+        return 1;
+    }
+
+    if (!storeReserve((void**) &aggregation->groups, &aggregation->capacity, NULL,
+                      aggregation->count + 1, sizeof(GroupCount))) return 0;
+    group = &aggregation->groups[aggregation->count];
+    group->location = location;
+    group->type = type;
+    group->priority = priority;
+    group->count = amount;
+    aggregation->table[pos] = aggregation->count++;
+    return 1;
+}
+
+/**
+ * @brief Merges every group of one aggregation into another.
+ */
+int aggregationMerge(Aggregation* target, const Aggregation* source) {
+    int i;
+    for (i = 0; i < source->count; i++) {
+        const GroupCount* group = &source->groups[i];
+        if (!aggregationAdd(target, group->location, group->type, group->priority, group->count)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Orders groups by count (descending), location name, type and priority.
+ */
+static int compareGroups(const void* a, const void* b) {
+    const GroupCount* ga = (const GroupCount*) a;
+    const GroupCount* gb = (const GroupCount*) b;
+    int byName;
+
+    if (ga->count != gb->count) return ga->count > gb->count ? -1 : 1;
+    byName = ga->location == gb->location ? 0 : strcmp(symbolText(ga->location), symbolText(gb->location));
+    if (byName != 0) return byName;
+    if (ga->type != gb->type) return ga->type - gb->type;
+    return ga->priority - gb->priority;
+}
+
+/**
+ * @brief Sorts the groups by count (most frequent first), then by location name.
+ */
+void aggregationSort(Aggregation* aggregation) {
+    free(aggregation->table);
+    aggregation->table = NULL;
+    aggregation->tableSize = 0;
+    if (aggregation->count > 1) qsort(aggregation->groups, aggregation->count, sizeof(GroupCount), compareGroups);
+}
+
+/**
+ * @brief Frees all memory used by the aggregation.
+ */
+void aggregationFree(Aggregation* aggregation) {
+    free(aggregation->groups);
+    free(aggregation->table);
+    aggregationInit(aggregation);
+}
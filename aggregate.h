@@ -0,0 +1,89 @@
+/**
+ * @file aggregate.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the hash aggregation engine used to count occurrences by location, type and priority.
+ */
+
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include "data.h"
+
+/**
+ * @brief Flags selecting the optional grouping keys (location is always a key).
+ */
+#define GROUP_BY_TYPE 1
+#define GROUP_BY_PRIORITY 2
+
+/**
+ * @brief One group of the aggregation and its count.
+ * Keys that are not grouped are stored as -1.
+ */
+typedef struct {
+    Symbol location;
+    int type;
+    int priority;
+    int count;
+} GroupCount;
+
+/**
+ * @brief Hash aggregation: groups in insertion order plus an open addressing table over them.
+ */
+typedef struct {
+    GroupCount* groups;
+    int count;
+    int capacity;
+    int* table;
+    int tableSize;
+} Aggregation;
+
+/**
+ * @brief Initializes an empty aggregation.
+ *
+ * @param aggregation Pointer to the aggregation.
+ */
+void aggregationInit(Aggregation* aggregation);
+
+/**
+ * @brief Adds an amount to the group with the given keys, creating the group if needed.
+ *
+ * @param aggregation Pointer to the aggregation.
+ * @param location Location key.
+ * @param type Type key (-1 if not grouped by type).
+ * @param priority Priority key (-1 if not grouped by priority).
+ * @param amount Amount to add to the group's count.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int aggregationAdd(Aggregation* aggregation, Symbol location, int type, int priority, int amount);
+
+/**
+ * @brief Merges every group of one aggregation into another.
+ *
+ * @param target Pointer to the aggregation receiving the counts.
+ * @param source Pointer to the aggregation to merge.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int aggregationMerge(Aggregation* target, const Aggregation* source);
+
+/**
+ * @brief Sorts the groups by count (most frequent first), then by location name.
+ *
+ * The hash table is discarded, so no more groups can be added after sorting.
+ *
+ * @param aggregation Pointer to the aggregation.
+ */
+void aggregationSort(Aggregation* aggregation);
+
+/**
+ * @brief Frees all memory used by the aggregation.
+ *
+ * @param aggregation Pointer to the aggregation.
+ */
+void aggregationFree(Aggregation* aggregation);
+
+#endif // AGGREGATE_H
@@ -0,0 +1,101 @@
+/**
+ * @file assignment.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the Hungarian algorithm for the assignment problem.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <limits.h>  // Provides the limits of the integer types (e.g., LONG_MAX)
+
+#include "assignment.h"
+
+#define INFINITE_COST (LONG_MAX / 4)
+
+/**
+ * @brief Assigns every row to a distinct column so that the total cost is minimal.
+ *
+ * Rows are added one at a time; each addition grows a tree of tight edges (reduced cost zero
+ * under the potentials u and v) until it reaches a free column, then flips the augmenting path.
+ * Arrays are 1-based, column 0 standing for the row being added.
+ */
+int solveAssignment(const long* cost, int rows, int cols, int* assignment) {
+    long* u;
+    long* v;
+    long* minReduced;
+    int* rowOfCol;
+    int* previous;
+    unsigned char* visited;
+    int i, j;
+
+    if (rows > cols) return 0;
+    if (rows == 0) return 1;
+
+    u = (long*) calloc(rows + 1, sizeof(long));
+    v = (long*) calloc(cols + 1, sizeof(long));
+    minReduced = (long*) malloc((cols + 1) * sizeof(long));
+    rowOfCol = (int*) calloc(cols + 1, sizeof(int));
+    previous = (int*) calloc(cols + 1, sizeof(int));
+    visited = (unsigned char*) malloc(cols + 1);
+    if (!u || !v || !minReduced || !rowOfCol || !previous || !visited) {
+        free(u); free(v); free(minReduced); free(rowOfCol); free(previous); free(visited);
+        return 0;
+    }
+
+    for (i = 1; i <= rows; i++) {
+        int col = 0;
+        rowOfCol[0] = i;
+        for (j = 0; j <= cols; j++) {
+            minReduced[j] = INFINITE_COST;
+            visited[j] = 0;
+        }
+
+        // Grow the tree until it reaches a free column.
+        do {
+            int row = rowOfCol[col], nextCol = 0;
+            long delta = INFINITE_COST;
+
+            visited[col] = 1;
+            for (j = 1; j <= cols; j++) {
+                if (!visited[j]) {
+                    long reduced = cost[(long) (row - 1) * cols + (j - 1)] - u[row] - v[j];
+                    if (reduced < minReduced[j]) {
+                        minReduced[j] = reduced;
+                        previous[j] = col;
+                    }
+                    if (minReduced[j] < delta) {
+                        delta = minReduced[j];
+                        nextCol = j;
+                    }
+                }
+            }
+            for (j = 0; j <= cols; j++) {
+                if (visited[j]) {
+                    u[rowOfCol[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minReduced[j] -= delta;
+                }
+            }
+            col = nextCol;
+        } while (rowOfCol[col] != 0);
+
+        // Flip the augmenting path back to the new row.
+        do {
+            int before = previous[col];
+            rowOfCol[col] = rowOfCol[before];
+            col = before;
+        } while (col != 0);
+    }
+
+    for (j = 1; j <= cols; j++) {
+        if (rowOfCol[j] != 0) assignment[rowOfCol[j] - 1] = j - 1;
+    }
+
+    free(u); free(v); free(minReduced); free(rowOfCol); free(previous); free(visited);
+    return 1;
+}
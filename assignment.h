@@ -0,0 +1,28 @@
+/**
+ * @file assignment.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares a solver for the assignment problem (minimum-cost bipartite matching).
+ */
+
+#ifndef ASSIGNMENT_H
+#define ASSIGNMENT_H
+
+/**
+ * @brief Assigns every row to a distinct column so that the total cost is minimal.
+ *
+ * Hungarian algorithm with potentials, O(rows^2 * cols). Costs may be negative.
+ *
+ * @param cost Cost matrix in row-major order (cost[r * cols + c]).
+ * @param rows Number of rows (must not exceed cols).
+ * @param cols Number of columns.
+ * @param assignment Array with room for rows entries; receives the column of each row.
+ * @return Returns 1 on success, 0 if rows > cols or memory could not be allocated.
+ */
+int solveAssignment(const long* cost, int rows, int cols, int* assignment);
+
+#endif // ASSIGNMENT_H
@@ -0,0 +1,197 @@
+/**
+ * @file batch.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the headless batch mode.
+ */
+
+#include <stdio.h>   // Provides standard input and output functions (e.g., fgets, fprintf)
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for string manipulation (e.g., strchr, strspn)
+
+#include "batch.h"
+#include "firefighters.h"
+#include "occurrences.h"
+#include "equipments.h"
+#include "interventions.h"
+#include "journal.h"
+#include "symbols.h"
+#include "datetime.h"
+
+#define MAX_FIELDS 6
+
+/**
+ * @brief Splits a line in place into ';' separated fields, trimming spaces around each one.
+ */
+static int splitFields(char* line, char** fields) {
+    int n = 0;
+    char* cursor = line;
+
+    for (;;) {
+        char* end = strchr(cursor, ';');
+        char* last;
+        if (end) *end = '\0';
+        while (*cursor == ' ' || *cursor == '\t') cursor++;
+        last = cursor + strlen(cursor);
+        while (last > cursor && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r' || last[-1] == '\n')) *--last = '\0';
+        if (n == MAX_FIELDS) return -1;
+        fields[n++] = cursor;
+        if (!end) return n;
+        cursor = end + 1;
+    }
+}
+
+/**
+ * @brief Parses a whole field as an integer in [min, max].
+ */
+static int parseInt(const char* text, int min, int max, int* value) {
+    char* end;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < min || parsed > max) return 0;
+    *value = (int) parsed;
+    return 1;
+}
+
+/**
+ * @brief Parses a list of IDs separated by spaces.
+ */
+static int parseIds(const char* text, int* ids, int max) {
+    int n = 0;
+    char* end;
+
+    for (;;) {
+        long id;
+        while (*text == ' ') text++;
+        if (*text == '\0') return n;
+        id = strtol(text, &end, 10);
+        if (end == text || id < 1 || id > MAX_ID || n == max || (*end != ' ' && *end != '\0')) return -1;
+        ids[n++] = (int) id;
+        text = end;
+    }
+}
+
+/**
+ * @brief Applies one command; returns 1 if it was applied, 0 if it was invalid or refused.
+ */
+static int applyCommand(char** field, int n, FirefighterStore* firefighters, int* idFirefighter,
+                        OccurrenceStore* occurrences, int* idOccurrence,
+                        EquipmentStore* equipments, int* idEquipment,
+                        InterventionStore* interventions, int* idIntervention) {
+    const char* code = field[0];
+    int id, value, other;
+    Timestamp date;
+
+    if (strlen(code) != 2) return 0;
+    // Every command but "+" starts with the ID of an existing record.
+    if (code[1] != '+' && (n < 2 || !parseInt(field[1], 1, MAX_ID, &id))) return 0;
+
+    switch (code[0]) {
+        case 'F':
+            if (code[1] == '+') return n == 3 && addFirefighter(firefighters, idFirefighter, internString(field[1]), internString(field[2])) != NULL;
+            if (code[1] == '=') return n == 3 && parseInt(field[2], 0, 2, &value) && changeFirefighterStatus(firefighters, id, (FirefighterStatus) value);
+            if (code[1] == '-') return n == 2 && removeFirefighter(firefighters, id);
+            return 0;
+        case 'E':
+            if (code[1] == '+') return n == 3 && addEquipment(equipments, idEquipment, internString(field[1]), internString(field[2])) != NULL;
+            if (code[1] == '=') return n == 3 && parseInt(field[2], 0, 2, &value) && changeEquipmentStatus(equipments, id, (EquipmentStatus) value);
+            if (code[1] == '-') return n == 2 && removeEquipment(equipments, id);
+            return 0;
+        case 'O':
+            if (code[1] == '+') {
+                return n == 5 && parseInt(field[2], 0, 2, &value) && parseInt(field[3], 0, 2, &other) && parseTimestamp(field[4], &date) &&
+                       addOccurrence(occurrences, idOccurrence, internString(field[1]), (OccurrenceType) value, (Priority) other, date) != NULL;
+            }
+            if (code[1] == '=') {
+                const Occurrence* current = findOccurrence(occurrences, id);
+                if ((n != 3 && n != 4) || !current || !parseInt(field[2], 0, 2, &value)) return 0;
+                date = current->endedAt;
+                if (n == 4 && !parseTimestamp(field[3], &date)) return 0;
+                // As in the menu, a resolved occurrence always has its end date.
+                if (value == RESOLVED && (n != 4 || date < current->timestamp)) return 0;
+                return changeOccurrenceStatus(occurrences, id, (OccurrenceStatus) value, date);
+            }
+            if (code[1] == '!') return n == 3 && parseInt(field[2], 0, 2, &value) && changeOccurrencePriority(occurrences, id, (Priority) value);
+            if (code[1] == '-') return n == 2 && cancelOccurrence(occurrences, id);
+            return 0;
+        case 'I':
+            if (code[1] == '+') {
+                Intervention request;
+                if (n != 5 || !parseInt(field[1], 1, MAX_ID, &request.idOccurrence) || !parseTimestamp(field[2], &request.start)) return 0;
+                request.crewCount = parseIds(field[3], request.crew, MAX_CREW);
+                request.equipmentCount = parseIds(field[4], request.equipment, MAX_INTERVENTION_EQUIPMENT);
+                if (request.crewCount < 1 || request.equipmentCount < 0) return 0;
+                return addIntervention(interventions, firefighters, equipments, idIntervention, &request) != NULL;
+            }
+            if (code[1] == '=') {
+                if ((n != 3 && n != 4) || !parseInt(field[2], 0, 2, &value)) return 0;
+                date = NO_TIMESTAMP;
+                if (n == 4 && !parseTimestamp(field[3], &date)) return 0;
+                if (value == FINISHED && n != 4) return 0;
+                return changeInterventionStatus(interventions, firefighters, equipments, id, (InterventionStatus) value, date);
+            }
+            if (code[1] == '-') return n == 2 && cancelIntervention(interventions, firefighters, equipments, id);
+            return 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Applies one command line.
+ */
+int applyBatchLine(char* line, FirefighterStore* firefighters, int* idFirefighter,
+                   OccurrenceStore* occurrences, int* idOccurrence,
+                   EquipmentStore* equipments, int* idEquipment,
+                   InterventionStore* interventions, int* idIntervention) {
+    char* fields[MAX_FIELDS];
+    char* start = line + strspn(line, " \t\r\n");
+    int n;
+
+    if (*start == '\0' || *start == '#') return -1;
+    n = splitFields(start, fields);
+    return n > 0 && applyCommand(fields, n, firefighters, idFirefighter, occurrences, idOccurrence,
+                                 equipments, idEquipment, interventions, idIntervention);
+}
+
+/**
+ * @brief Applies every command of a stream to the stores.
+ */
+int runBatch(FILE* input, FirefighterStore* firefighters, int* idFirefighter,
+             OccurrenceStore* occurrences, int* idOccurrence,
+             EquipmentStore* equipments, int* idEquipment,
+             InterventionStore* interventions, int* idIntervention) {
+    char line[BATCH_LINE];
+    int lineNumber = 0, applied = 0, rejected = 0;
+
+    while (fgets(line, sizeof(line), input)) {
+        int result;
+        lineNumber++;
+
+        if (!strchr(line, '\n') && !feof(input)) {
+            int c;
+            while ((c = fgetc(input)) != '\n' && c != EOF);
+            fprintf(stderr, "Linha %d: demasiado longa.\n", lineNumber);
+            rejected++;
+            continue;
+        }
+        result = applyBatchLine(line, firefighters, idFirefighter, occurrences, idOccurrence,
+                                equipments, idEquipment, interventions, idIntervention);
+        if (result < 0) continue;
+        if (result) {
+            applied++;
+        } else {
+            fprintf(stderr, "Linha %d: comando inválido ou recusado.\n", lineNumber);
+            rejected++;
+        }
+
+        if (journalPending() >= JOURNAL_CHECKPOINT_ENTRIES) {
+            journalCheckpoint(firefighters, occurrences, equipments, interventions);
+        }
+    }
+
+    fprintf(stderr, "%d comando(s) aplicado(s), %d rejeitado(s).\n", applied, rejected);
+    return rejected;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file batch.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.1
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the headless batch mode: applies a stream of commands without any prompt.
+ *
+ * One command per line, fields separated by ';' (text fields may contain spaces). Empty lines
+ * and lines starting with '#' are ignored. Dates are written "dd/mm/yyyy hh:mm".
+ *
+ *     F+;name;specialty              F=;id;status        F-;id
+ *     E+;designation;type            E=;id;status        E-;id
+ *     O+;location;type;priority;date O=;id;status[;end]  O!;id;priority   O-;id
+ *     I+;occurrence;start;crew IDs;equipment IDs         I=;id;status[;end] I-;id
+ *
+ * Statuses, types and priorities are the numbers used by the menus. The crew and equipment of
+ * "I+" are IDs separated by spaces (the equipment list may be empty). The end date is required
+ * when "O=" sets RESOLVED or "I=" sets FINISHED. Commands go through the same functions as the
+ * menus, so they are validated, journaled and indexed the same way.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h> // Provides FILE
+
+#include "data.h"
+
+/**
+ * @brief Longest command line accepted.
+ */
+#define BATCH_LINE 1024
+
+/**
+ * @brief Applies one command line to the stores.
+ *
+ * @param line Command line (modified in place).
+ * @param firefighters Pointer to the firefighter store.
+ * @param idFirefighter Pointer to the firefighter ID counter.
+ * @param occurrences Pointer to the occurrence store.
+ * @param idOccurrence Pointer to the occurrence ID counter.
+ * @param equipments Pointer to the equipment store.
+ * @param idEquipment Pointer to the equipment ID counter.
+ * @param interventions Pointer to the intervention store.
+ * @param idIntervention Pointer to the intervention ID counter.
+ * @return Returns 1 if it was applied, 0 if it was invalid or refused, -1 for an empty line or comment.
+ */
+int applyBatchLine(char* line, FirefighterStore* firefighters, int* idFirefighter,
+                   OccurrenceStore* occurrences, int* idOccurrence,
+                   EquipmentStore* equipments, int* idEquipment,
+                   InterventionStore* interventions, int* idIntervention);
+
+/**
+ * @brief Applies every command of a stream to the stores.
+ *
+ * Invalid or refused commands are reported on stderr with their line number and skipped.
+ * The journal is checkpointed every JOURNAL_CHECKPOINT_ENTRIES changes, as in the menus.
+ *
+ * @param input Stream of commands.
+ * @param firefighters Pointer to the firefighter store.
+ * @param idFirefighter Pointer to the firefighter ID counter.
+ * @param occurrences Pointer to the occurrence store.
+ * @param idOccurrence Pointer to the occurrence ID counter.
+ * @param equipments Pointer to the equipment store.
+ * @param idEquipment Pointer to the equipment ID counter.
+ * @param interventions Pointer to the intervention store.
+ * @param idIntervention Pointer to the intervention ID counter.
+ * @return Returns the number of commands that were not applied.
+ */
+int runBatch(FILE* input, FirefighterStore* firefighters, int* idFirefighter,
+             OccurrenceStore* occurrences, int* idOccurrence,
+             EquipmentStore* equipments, int* idEquipment,
+             InterventionStore* interventions, int* idIntervention);
+
+#endif // BATCH_H
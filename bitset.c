@@ -0,0 +1,122 @@
+/**
+ * @file bitset.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the dense bitsets.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for memory manipulation (e.g., memset)
+
+#include "bitset.h"
+
+/**
+ * @brief Returns the position of the lowest set bit of a nonzero word.
+ */
+static int lowestBit(BitWord word) {
+#if defined(__GNUC__)
+    return __builtin_ctzl(word);
+#else
+    int position = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        position++;
+    }
+    return position;
+#endif
+}
+
+/**
+ * @brief Returns the number of set bits of a word.
+ */
+static int countBits(BitWord word) {
+#if defined(__GNUC__)
+    return __builtin_popcountl(word);
+#else
+    int count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Initializes an empty bitset.
+ */
+void bitsetInit(Bitset* bits) {
+    bits->words = NULL;
+    bits->wordCount = 0;
+}
+
+/**
+ * @brief Sets or clears the bit of a slot, growing the bitset if needed.
+ */
+int bitsetAssign(Bitset* bits, int slot, int value) {
+    int word = slot / BITS_PER_WORD;
+    BitWord mask = (BitWord) 1 << (slot % BITS_PER_WORD);
+
+    if (word >= bits->wordCount) {
+        int newCount = bits->wordCount ? bits->wordCount : 4;
+        BitWord* grown;
+        if (!value) return 1;
+        while (newCount <= word) newCount *= 2;
+        grown = (BitWord*) realloc(bits->words, newCount * sizeof(BitWord));
+        if (!grown) return 0;
+        memset(grown + bits->wordCount, 0, (newCount - bits->wordCount) * sizeof(BitWord));
+        bits->words = grown;
+        bits->wordCount = newCount;
+    }
+    if (value) bits->words[word] |= mask;
+    else bits->words[word] &= ~mask;
+    return 1;
+}
+
+/**
+ * @brief Tells whether the bit of a slot is set.
+ */
+int bitsetTest(const Bitset* bits, int slot) {
+    int word = slot / BITS_PER_WORD;
+    if (slot < 0 || word >= bits->wordCount) return 0;
+    return (bits->words[word] >> (slot % BITS_PER_WORD)) & 1;
+}
+
+/**
+ * @brief Returns the number of slots set.
+ */
+int bitsetCount(const Bitset* bits) {
+    int i, count = 0;
+    for (i = 0; i < bits->wordCount; i++) count += countBits(bits->words[i]);
+    return count;
+}
+
+/**
+ * @brief Collects the first slots set in both bitsets, one word (64 resources) per AND.
+ */
+int bitsetCollectAnd(const Bitset* a, const Bitset* b, int limit, int* slots) {
+    int words = a->wordCount;
+    int i, found = 0;
+
+    if (b && b->wordCount < words) words = b->wordCount;
+    for (i = 0; i < words && found < limit; i++) {
+        BitWord word = b ? a->words[i] & b->words[i] : a->words[i];
+        while (word && found < limit) {
+            slots[found++] = i * BITS_PER_WORD + lowestBit(word);
+            word &= word - 1;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Frees the memory of a bitset.
+ */
+void bitsetFree(Bitset* bits) {
+    free(bits->words);
+    bitsetInit(bits);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file bitset.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares dense bitsets indexed by store slot.
+ *
+ * A bit per resource (e.g. "available", "forest specialty") packed into machine words, so set
+ * operations over thousands of resources are a few word-wide ANDs.
+ */
+
+#ifndef BITSET_H
+#define BITSET_H
+
+/**
+ * @brief Word holding the bits (64 of them on LP64 systems).
+ */
+typedef unsigned long BitWord;
+
+#define BITS_PER_WORD ((int) (sizeof(BitWord) * 8))
+
+/**
+ * @brief Growable set of slots.
+ */
+typedef struct {
+    BitWord* words;
+    int wordCount;
+} Bitset;
+
+/**
+ * @brief Initializes an empty bitset.
+ *
+ * @param bits Pointer to the bitset.
+ */
+void bitsetInit(Bitset* bits);
+
+/**
+ * @brief Sets or clears the bit of a slot, growing the bitset if needed.
+ *
+ * @param bits Pointer to the bitset.
+ * @param slot Slot whose bit changes.
+ * @param value Nonzero to set the bit, 0 to clear it.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int bitsetAssign(Bitset* bits, int slot, int value);
+
+/**
+ * @brief Tells whether the bit of a slot is set.
+ *
+ * @param bits Pointer to the bitset.
+ * @param slot Slot to check.
+ * @return Returns 1 if the bit is set, 0 otherwise.
+ */
+int bitsetTest(const Bitset* bits, int slot);
+
+/**
+ * @brief Returns the number of slots set.
+ *
+ * @param bits Pointer to the bitset.
+ * @return Returns the number of bits set.
+ */
+int bitsetCount(const Bitset* bits);
+
+/**
+ * @brief Collects the first slots set in both bitsets (a AND b), in slot order.
+ *
+ * @param a Pointer to the first bitset.
+ * @param b Pointer to the second bitset, or NULL to use a alone.
+ * @param limit Maximum number of slots to collect.
+ * @param slots Array with room for limit slots.
+ * @return Returns the number of slots written.
+ */
+int bitsetCollectAnd(const Bitset* a, const Bitset* b, int limit, int* slots);
+
+/**
+ * @brief Frees the memory of a bitset and leaves it empty.
+ *
+ * @param bits Pointer to the bitset.
+ */
+void bitsetFree(Bitset* bits);
+
+#endif // BITSET_H
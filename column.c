@@ -0,0 +1,168 @@
+/**
+ * @file column.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of byte columns and their vectorized count and filter kernels.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for memory manipulation (e.g., memset)
+
+#include "column.h"
+#include "store.h"
+
+// The vector kernels are built for x86 with GCC/Clang; AVX2 is chosen at run time if the CPU has it.
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define COLUMN_SIMD 1
+#include <immintrin.h> // Provides SSE2/AVX2 intrinsics (e.g., _mm_cmpeq_epi8)
+#endif
+
+/**
+ * @brief Initializes an empty column.
+ */
+void columnInit(ByteColumn* column) {
+    column->values = NULL;
+    column->capacity = 0;
+}
+
+/**
+ * @brief Sets the byte of a slot, growing the column if needed.
+ */
+int columnSet(ByteColumn* column, int slot, unsigned char value) {
+    int oldCapacity = column->capacity;
+    if (!storeReserve((void**) &column->values, &column->capacity, NULL, slot + 1, 1)) return 0;
+    if (column->capacity > oldCapacity) memset(column->values + oldCapacity, COLUMN_NONE, column->capacity - oldCapacity);
+    column->values[slot] = value;
+    return 1;
+}
+
+/**
+ * @brief Tells whether one slot meets every key (scalar path, also used for the tail of the vector kernels).
+ */
+static int matches(const ColumnKey* keys, int keyCount, int slot) {
+    int k;
+    for (k = 0; k < keyCount; k++) {
+        if (keys[k].column->values[slot] != keys[k].value) return 0;
+    }
+    return 1;
+}
+
+#ifdef COLUMN_SIMD
+
+/**
+ * @brief Bit i of the result is set when slot from + i meets every key (16 slots, SSE2).
+ */
+static unsigned int matchMask16(const ColumnKey* keys, int keyCount, int from) {
+    __m128i match = _mm_set1_epi8(-1);
+    int k;
+    for (k = 0; k < keyCount; k++) {
+        __m128i values = _mm_loadu_si128((const __m128i*) (keys[k].column->values + from));
+        match = _mm_and_si128(match, _mm_cmpeq_epi8(values, _mm_set1_epi8((char) keys[k].value)));
+    }
+    return (unsigned int) _mm_movemask_epi8(match);
+}
+
+/**
+ * @brief Bit i of the result is set when slot from + i meets every key (32 slots, AVX2).
+ */
+__attribute__((target("avx2")))
+static unsigned int matchMask32(const ColumnKey* keys, int keyCount, int from) {
+    __m256i match = _mm256_set1_epi8(-1);
+    int k;
+    for (k = 0; k < keyCount; k++) {
+        __m256i values = _mm256_loadu_si256((const __m256i*) (keys[k].column->values + from));
+        match = _mm256_and_si256(match, _mm256_cmpeq_epi8(values, _mm256_set1_epi8((char) keys[k].value)));
+    }
+    return (unsigned int) _mm256_movemask_epi8(match);
+}
+
+/**
+ * @brief Tells whether the AVX2 kernel can run on this CPU (checked once).
+ */
+static int hasAvx2(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return supported;
+}
+
+/**
+ * @brief Match mask of the block starting at slot from; *width receives the number of slots it covers.
+ */
+static unsigned int matchBlock(const ColumnKey* keys, int keyCount, int from, int count, int* width) {
+    if (count - from >= 32 && hasAvx2()) {
+        *width = 32;
+        return matchMask32(keys, keyCount, from);
+    }
+    if (count - from >= 16) {
+        *width = 16;
+        return matchMask16(keys, keyCount, from);
+    }
+    *width = 0;
+    return 0;
+}
+
+#endif
+
+/**
+ * @brief Counts the slots among the first count that meet every key.
+ */
+int columnCount(const ColumnKey* keys, int keyCount, int count) {
+    int total = 0;
+    int slot = 0;
+
+    if (keyCount == 0) return count;
+#ifdef COLUMN_SIMD
+    for (;;) {
+        int width;
+        unsigned int mask = matchBlock(keys, keyCount, slot, count, &width);
+        if (width == 0) break;
+        total += __builtin_popcount(mask);
+        slot += width;
+    }
+#endif
+    for (; slot < count; slot++) total += matches(keys, keyCount, slot);
+    return total;
+}
+
+/**
+ * @brief Collects the first slots that meet every key, in slot order.
+ */
+int columnFilter(const ColumnKey* keys, int keyCount, int count, int limit, int* slots) {
+    int found = 0;
+    int slot = 0;
+
+#ifdef COLUMN_SIMD
+    if (keyCount > 0) {
+        while (found < limit) {
+            int width;
+            unsigned int mask = matchBlock(keys, keyCount, slot, count, &width);
+            if (width == 0) break;
+            while (mask && found < limit) {
+                slots[found++] = slot + __builtin_ctz(mask);
+                mask &= mask - 1;
+            }
+            slot += width;
+        }
+        if (found == limit) return found;
+    }
+#endif
+    for (; slot < count && found < limit; slot++) {
+        if (matches(keys, keyCount, slot)) slots[found++] = slot;
+    }
+    return found;
+}
+
+/**
+ * @brief Frees the memory of a column and leaves it empty.
+ */
+void columnFree(ByteColumn* column) {
+    free(column->values);
+    columnInit(column);
+}
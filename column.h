@@ -0,0 +1,86 @@
+/**
+ * @file column.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares byte columns: one small field (status, type, priority) of every record, packed densely.
+ *
+ * Counting or filtering records by such fields through the records themselves reads a whole
+ * record per byte of interest. A column keeps the field of slot i at byte i, so the kernels below
+ * compare 16 (SSE2) or 32 (AVX2) records per instruction, with a plain loop as the fallback.
+ */
+
+#ifndef COLUMN_H
+#define COLUMN_H
+
+/**
+ * @brief Value of a slot that was never set.
+ */
+#define COLUMN_NONE 0xFF
+
+/**
+ * @brief Growable array of one byte per slot.
+ */
+typedef struct {
+    unsigned char* values;
+    int capacity;
+} ByteColumn;
+
+/**
+ * @brief A condition on a column: the byte of the slot equals value.
+ */
+typedef struct {
+    const ByteColumn* column;
+    unsigned char value;
+} ColumnKey;
+
+/**
+ * @brief Initializes an empty column.
+ *
+ * @param column Pointer to the column.
+ */
+void columnInit(ByteColumn* column);
+
+/**
+ * @brief Sets the byte of a slot, growing the column if needed.
+ *
+ * @param column Pointer to the column.
+ * @param slot Slot to set.
+ * @param value New value.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int columnSet(ByteColumn* column, int slot, unsigned char value);
+
+/**
+ * @brief Counts the slots among the first count that meet every key.
+ *
+ * @param keys Conditions (every column must hold at least count slots).
+ * @param keyCount Number of conditions (0 counts every slot).
+ * @param count Number of slots to check.
+ * @return Returns the number of matching slots.
+ */
+int columnCount(const ColumnKey* keys, int keyCount, int count);
+
+/**
+ * @brief Collects the first slots that meet every key, in slot order.
+ *
+ * @param keys Conditions (every column must hold at least count slots).
+ * @param keyCount Number of conditions (0 matches every slot).
+ * @param count Number of slots to check.
+ * @param limit Maximum number of slots to collect.
+ * @param slots Array with room for limit slots.
+ * @return Returns the number of slots written.
+ */
+int columnFilter(const ColumnKey* keys, int keyCount, int count, int limit, int* slots);
+
+/**
+ * @brief Frees the memory of a column and leaves it empty.
+ *
+ * @param column Pointer to the column.
+ */
+void columnFree(ByteColumn* column);
+
+#endif // COLUMN_H
@@ -2,7 +2,7 @@
  * @file data.h
  * @author Afonso Mendes
  * @author Rodrigo Ferreira
- * @version 1.2
+ * @version 1.10
  *
  * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
  *
@@ -13,12 +13,29 @@
 #ifndef DATA_H
 #define DATA_H
 
+#include <stddef.h> // Provides size_t
+
+#include "idindex.h"
+#include "heap.h"
+#include "schedule.h"
+#include "bitset.h"
+#include "histogram.h"
+#include "rollup.h"
+#include "column.h"
+
 // Constants
 #define MAX_STRING 100
+#define MAX_ID 999999999         // Highest entity ID accepted by the menus, batch commands and imports
 #define FILE_FIREFIGHTERS "firefighters.bin"
 #define FILE_OCCURRENCES "occurrences.bin"
 #define FILE_EQUIPMENTS "equipments.bin"
 #define FILE_INTERVENTIONS "interventions.bin"
+#define FILE_JOURNAL "journal.bin"
+#define FILE_SYMBOLS "strings.bin"
+#define FILE_ROLLUP "occurrences.rollup.bin"
+#define FILE_TAIL "tail.bin"
+#define MAX_CREW 8               // Firefighters per intervention
+#define MAX_INTERVENTION_EQUIPMENT 4 // Equipment items per intervention
 
 // Enumerations
 
@@ -40,6 +57,12 @@ typedef enum {
     HIGH
 } Priority;
 
+/**
+ * @brief Index of the statistics of an occurrence type and priority in a HistogramGrid.
+ */
+#define TYPE_PRIORITY_CELL(type, priority) ((type) * 3 + (priority))
+#define TYPE_PRIORITY_CELLS 9
+
 /**
  * @brief Represents the lifecycle status of an occurrence.
  * @note OCCURRENCE_INACTIVE is used for soft-delete (history preservation).
@@ -83,92 +106,163 @@ typedef enum {
 // Structures
 
 /**
- * @brief Structure to represent Date and Time.
+ * @brief Interned text (see symbols.h): a 32-bit ID stored in records instead of the characters.
+ */
+typedef int Symbol;
+
+/**
+ * @brief Structure to represent Date and Time (calendar form, used for input and display).
  */
 typedef struct {
     int day, month, year;
     int hour, minute;
 } DateTime;
 
+/**
+ * @brief Packed date and time stored in records: minutes since 1970-01-01 00:00 (see datetime.h).
+ * 32 bits cover well beyond the year 5000.
+ */
+typedef int Timestamp;
+
+/**
+ * @brief Value of a Timestamp that was not set (e.g. an occurrence that has not ended).
+ */
+#define NO_TIMESTAMP 0
+
 /**
  * @brief Structure representing a Firefighter entity.
  */
 typedef struct {
     int id;
-    char name[MAX_STRING];
-    char specialty[MAX_STRING];
+    Symbol name;
+    Symbol specialty;
     FirefighterStatus status;
     int totalInterventions;
     int totalResponseTime;
 } Firefighter;
 
 /**
- * @brief Linked List Node for Firefighters.
- * Implements a dynamic list to store firefighter data.
+ * @brief Contiguous store of Firefighters.
+ * Records live in a growable array (amortized O(1) append, linear iteration)
+ * and are located by ID through a hash index holding their slot. After loading,
+ * the array may be a private (copy-on-write) mapping of the data file.
  */
-typedef struct FirefighterNode {
-    Firefighter data;
-    struct FirefighterNode* next;
-} FirefighterNode;
+typedef struct {
+    Firefighter* items;
+    int count;
+    int capacity;
+    size_t mappedSize; /**< Bytes mapped from the data file, header included (0 when the array lives on the heap). */
+    int persistedCount; /**< Records already in the data file (record i follows the file header at i * sizeof). */
+    unsigned char* dirty; /**< Dirty flag of each persisted record, rewritten in place on save. */
+    IdIndex index;
+    int statusCount[3]; /**< Number of firefighters in each FirefighterStatus, kept current on every change. */
+    Heap available; /**< AVAILABLE firefighters, least loaded (totalInterventions) first, for dispatch recommendations. */
+    Heap availableFor[3]; /**< The same, restricted to the specialty matching each OccurrenceType. */
+    Bitset availableBits; /**< Bit per slot: firefighter is AVAILABLE. */
+    Bitset specialtyBits[3]; /**< Bit per slot: specialty matches each OccurrenceType (whatever the status). */
+} FirefighterStore;
 
 /**
  * @brief Structure representing an Occurrence (Incident).
  */
 typedef struct {
     int id;
-    char location[MAX_STRING];
-    DateTime timestamp;
-    DateTime endedAt;
+    Symbol location;
+    Timestamp timestamp;
+    Timestamp endedAt;
     OccurrenceType type;
     Priority priority;
     OccurrenceStatus status;
 } Occurrence;
 
 /**
- * @brief Linked List Node for Occurrences.
+ * @brief Contiguous store of Occurrences.
+ * Records live in a growable array (amortized O(1) append, linear iteration)
+ * and are located by ID through a hash index holding their slot. After loading,
+ * the array may be a private (copy-on-write) mapping of the data file.
  */
-typedef struct OccurrenceNode {
-    Occurrence data;
-    struct OccurrenceNode* next;
-} OccurrenceNode;
+typedef struct {
+    Occurrence* items;
+    int count;
+    int capacity;
+    size_t mappedSize; /**< Bytes mapped from the data file, header included (0 when the array lives on the heap). */
+    int persistedCount; /**< Records already in the data file (record i follows the file header at i * sizeof). */
+    unsigned char* dirty; /**< Dirty flag of each persisted record, rewritten in place on save. */
+    IdIndex index;
+    int* byTime; /**< Slots ordered by timestamp (then ID), for date-range queries in logarithmic time. */
+    int byTimeCapacity;
+    Heap dispatch; /**< REPORTED occurrences, highest priority then oldest first (dispatch queue). */
+    HistogramGrid resolutionTimes; /**< Resolution time (minutes) of RESOLVED occurrences, per TYPE_PRIORITY_CELL. */
+    ByteColumn statusColumn; /**< OccurrenceStatus of each slot, for vectorized counts and filters. */
+    ByteColumn typeColumn; /**< OccurrenceType of each slot. */
+    ByteColumn priorityColumn; /**< Priority of each slot. */
+    Rollup rollup; /**< Counts and resolution times per hour/day/month, type, priority and location. */
+} OccurrenceStore;
 
 /**
  * @brief Structure representing Equipment.
  */
 typedef struct {
     int id;
-    char designation[MAX_STRING];
-    char type[MAX_STRING];
+    Symbol designation;
+    Symbol type;
     EquipmentStatus status;
 } Equipment;
 
 /**
- * @brief Linked List Node for Equipment.
+ * @brief Contiguous store of Equipment.
+ * Records live in a growable array (amortized O(1) append, linear iteration)
+ * and are located by ID through a hash index holding their slot. After loading,
+ * the array may be a private (copy-on-write) mapping of the data file.
  */
-typedef struct EquipmentNode {
-    Equipment data;
-    struct EquipmentNode* next;
-} EquipmentNode;
+typedef struct {
+    Equipment* items;
+    int count;
+    int capacity;
+    size_t mappedSize; /**< Bytes mapped from the data file, header included (0 when the array lives on the heap). */
+    int persistedCount; /**< Records already in the data file (record i follows the file header at i * sizeof). */
+    unsigned char* dirty; /**< Dirty flag of each persisted record, rewritten in place on save. */
+    IdIndex index;
+    int statusCount[4]; /**< Number of equipment items in each EquipmentStatus, kept current on every change. */
+    Heap operational; /**< OPERATIONAL equipment, lowest ID first, for dispatch recommendations. */
+    Heap operationalFor[3]; /**< The same, restricted to the designation or type matching each OccurrenceType. */
+    Bitset operationalBits; /**< Bit per slot: equipment is OPERATIONAL. */
+    Bitset typeBits[3]; /**< Bit per slot: designation or type matches each OccurrenceType (whatever the status). */
+} EquipmentStore;
 
 /**
  * @brief Structure representing an Intervention.
- * Links an Occurrence to the resources (Firefighter/Equipment) assigned to it.
+ * Links an Occurrence to the resources (Firefighters/Equipment) assigned to it.
  */
 typedef struct {
     int id;
     int idOccurrence;
-    DateTime start;
-    DateTime end;
+    Timestamp start;
+    Timestamp end;
     InterventionStatus status;
-    int assignedFirefighterId;
+    int crew[MAX_CREW]; /**< IDs of the firefighters (crew[0] leads). */
+    int crewCount;
+    int equipment[MAX_INTERVENTION_EQUIPMENT]; /**< IDs of the equipment items. */
+    int equipmentCount;
 } Intervention;
 
 /**
- * @brief Linked List Node for Interventions.
+ * @brief Contiguous store of Interventions.
+ * Records live in a growable array (amortized O(1) append, linear iteration)
+ * and are located by ID through a hash index holding their slot. After loading,
+ * the array may be a private (copy-on-write) mapping of the data file.
  */
-typedef struct InterventionNode {
-    Intervention data;
-    struct InterventionNode* next;
-} InterventionNode;
+typedef struct {
+    Intervention* items;
+    int count;
+    int capacity;
+    size_t mappedSize; /**< Bytes mapped from the data file, header included (0 when the array lives on the heap). */
+    int persistedCount; /**< Records already in the data file (record i follows the file header at i * sizeof). */
+    unsigned char* dirty; /**< Dirty flag of each persisted record, rewritten in place on save. */
+    IdIndex index;
+    Schedule schedule; /**< Window of every active intervention in its firefighter's interval tree (overlap checks). */
+    HistogramGrid durations; /**< Duration (minutes) of FINISHED interventions, per TYPE_PRIORITY_CELL of their occurrence. */
+    const OccurrenceStore* occurrences; /**< Occurrences the interventions refer to (classifies the durations). */
+} InterventionStore;
 
 #endif // DATA_H
\ No newline at end of file
@@ -0,0 +1,115 @@
+/**
+ * @file datetime.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the calendar conversions and date input.
+ */
+
+#include <stdio.h>   // Provides standard input and output functions (e.g., printf, scanf)
+
+#include "datetime.h"
+#include "input.h"
+
+#define MINUTES_PER_DAY 1440
+
+/**
+ * @brief Returns the number of days of a month.
+ */
+int daysInMonth(int month, int year) {
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : days[month - 1];
+}
+
+/**
+ * @brief Days since 1970-01-01 of a civil date (H. Hinnant's days_from_civil).
+ */
+static long daysFromCivil(int year, int month, int day) {
+    long era, yoe, doy, doe;
+    year -= month <= 2;
+    era = (year >= 0 ? year : year - 399) / 400;
+    yoe = year - era * 400;
+    doy = (153L * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097L + doe - 719468L;
+}
+
+/**
+ * @brief Converts a calendar date to a timestamp.
+ */
+Timestamp toTimestamp(DateTime dt) {
+    return (Timestamp) (daysFromCivil(dt.year, dt.month, dt.day) * MINUTES_PER_DAY + dt.hour * 60 + dt.minute);
+}
+
+/**
+ * @brief Converts a timestamp back to a calendar date (H. Hinnant's civil_from_days).
+ */
+DateTime fromTimestamp(Timestamp t) {
+    DateTime dt;
+    long days = t >= 0 ? t / MINUTES_PER_DAY : -((-t + MINUTES_PER_DAY - 1) / MINUTES_PER_DAY);
+    long minutes = t - days * MINUTES_PER_DAY;
+    long z = days + 719468L;
+    long era = (z >= 0 ? z : z - 146096L) / 146097L;
+    long doe = z - era * 146097L;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+
+    dt.day = (int) (doy - (153 * mp + 2) / 5 + 1);
+    dt.month = (int) (mp < 10 ? mp + 3 : mp - 9);
+    dt.year = (int) (yoe + era * 400 + (dt.month <= 2));
+    dt.hour = (int) (minutes / 60);
+    dt.minute = (int) (minutes % 60);
+    return dt;
+}
+
+/**
+ * @brief Writes a timestamp as "dd/mm/yyyy hh:mm".
+ */
+void formatTimestamp(Timestamp t, char* buffer) {
+    DateTime dt;
+    if (t == NO_TIMESTAMP) {
+        sprintf(buffer, "-");
+        return;
+    }
+    dt = fromTimestamp(t);
+    sprintf(buffer, "%02d/%02d/%04d %02d:%02d", dt.day % 100, dt.month % 100, dt.year % 10000, dt.hour % 100, dt.minute % 100);
+}
+
+/**
+ * @brief Parses a date written as "dd/mm/yyyy hh:mm".
+ */
+int parseTimestamp(const char* text, Timestamp* t) {
+    DateTime dt;
+    char rest;
+    if (sscanf(text, " %d/%d/%d %d:%d %c", &dt.day, &dt.month, &dt.year, &dt.hour, &dt.minute, &rest) != 5) return 0;
+    if (dt.year < 1970 || dt.year > TIMESTAMP_MAX_YEAR || dt.month < 1 || dt.month > 12) return 0;
+    if (dt.day < 1 || dt.day > daysInMonth(dt.month, dt.year)) return 0;
+    if (dt.hour < 0 || dt.hour > 23 || dt.minute < 0 || dt.minute > 59) return 0;
+    *t = toTimestamp(dt);
+    return *t != NO_TIMESTAMP; // Would be read back as "no date"
+}
+
+/**
+ * @brief Helper function to read date and time from user input.
+ *
+ * @return Returns the date as a timestamp.
+ */
+Timestamp readDateTime(void) {
+    DateTime dt;
+    printf("--- Data e Hora ---\n");
+    dt.day = getInt(1, 31, "Dia: ");
+    dt.month = getInt(1, 12, "Mês: ");
+    dt.year = getInt(2020, 2030, "Ano: ");
+    if (dt.day > daysInMonth(dt.month, dt.year)) {
+        printf("O mês indicado só tem %d dias.\n", daysInMonth(dt.month, dt.year));
+        dt.day = getInt(1, daysInMonth(dt.month, dt.year), "Dia: ");
+    }
+    dt.hour = getInt(0, 23, "Hora: ");
+    dt.minute = getInt(0, 59, "Minuto: ");
+    return toTimestamp(dt);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file datetime.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the conversions between calendar dates (DateTime) and packed timestamps.
+ *
+ * Records store a Timestamp (minutes since 1970-01-01 00:00, proleptic Gregorian calendar), so
+ * comparing, sorting and subtracting dates are single integer operations and month and year
+ * boundaries (including leap years) are handled exactly.
+ */
+
+#ifndef DATETIME_H
+#define DATETIME_H
+
+#include "data.h"
+
+/**
+ * @brief Size of the buffer needed by formatTimestamp ("dd/mm/yyyy hh:mm" plus terminator).
+ */
+#define TIMESTAMP_TEXT 17
+
+/**
+ * @brief Latest year accepted when parsing dates (a Timestamp overflows after the year 6053).
+ */
+#define TIMESTAMP_MAX_YEAR 4999
+
+/**
+ * @brief Returns the number of days of a month.
+ *
+ * @param month Month (1-12).
+ * @param year Year (used for February in leap years).
+ * @return Returns the number of days (28-31).
+ */
+int daysInMonth(int month, int year);
+
+/**
+ * @brief Converts a calendar date to a timestamp.
+ *
+ * @param dt Calendar date and time.
+ * @return Returns the number of minutes since 1970-01-01 00:00.
+ */
+Timestamp toTimestamp(DateTime dt);
+
+/**
+ * @brief Converts a timestamp back to a calendar date.
+ *
+ * @param t Timestamp (minutes since 1970-01-01 00:00).
+ * @return Returns the calendar date and time.
+ */
+DateTime fromTimestamp(Timestamp t);
+
+/**
+ * @brief Writes a timestamp as "dd/mm/yyyy hh:mm" (or "-" if it is not set).
+ *
+ * @param t Timestamp to format.
+ * @param buffer Buffer with at least TIMESTAMP_TEXT characters.
+ */
+void formatTimestamp(Timestamp t, char* buffer);
+
+/**
+ * @brief Parses a date written as "dd/mm/yyyy hh:mm" (the format of formatTimestamp).
+ *
+ * Years from 1970 to TIMESTAMP_MAX_YEAR are accepted, except 01/01/1970 00:00, which is NO_TIMESTAMP.
+ *
+ * @param text Text to parse (leading and trailing spaces are ignored).
+ * @param t Pointer to receive the timestamp.
+ * @return Returns 1 on success, 0 if the text is not a valid date.
+ */
+int parseTimestamp(const char* text, Timestamp* t);
+
+/**
+ * @brief Reads a valid calendar date and time from user input.
+ *
+ * @return Returns the date as a timestamp.
+ */
+Timestamp readDateTime(void);
+
+#endif // DATETIME_H
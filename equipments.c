@@ -13,15 +13,22 @@
 #include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
 
 #include "equipments.h"
+#include "occurrences.h"
+#include "store.h"
+#include "journal.h"
+#include "symbols.h"
 #include "input.h"
 
+#define EQUIPMENTS_MAGIC 0x50495145 // "EQIP"
+#define EQUIPMENTS_VERSION 1
+
 /**
  * @brief Displays the Equipment management menu.
  *
- * @param head Double pointer to the head of the linked list.
+ * @param store Pointer to the equipment store.
  * @param idSeq Pointer to the ID sequence counter.
  */
-void menuEquipments(EquipmentNode** head, int* idSeq) {
+void menuEquipments(EquipmentStore* store, int* idSeq) {
     int op;
     do {
         printf("\n--- GESTÃO DE EQUIPAMENTOS ---\n");
@@ -29,81 +36,225 @@ void menuEquipments(EquipmentNode** head, int* idSeq) {
         op = getInt(0, 4, "Opção: ");
         switch (op) {
             case 1:
-                *head = createEquipment(*head, idSeq);
+                createEquipment(store, idSeq);
             break;
             case 2:
-                listEquipments(*head);
+                listEquipments(store);
             break;
             case 3:
-                updateEquipment(*head);
+                updateEquipment(store);
             break;
             case 4:
-                *head = deleteEquipment(*head);
+                deleteEquipment(store);
             break;
         }
     } while (op != 0);
 }
 
 /**
- * @brief Creates a new equipment item and adds it to the list.
+ * @brief Heap order of the operational queues: lowest ID first.
+ */
+static int lowerId(const void* context, int a, int b) {
+    const Equipment* items = ((const EquipmentStore*) context)->items;
+    return items[a].id < items[b].id;
+}
+
+/**
+ * @brief Puts an equipment item in (or takes it out of) the operational queues after a change.
+ */
+static void trackAvailability(EquipmentStore* store, int slot) {
+    const Equipment* record = &store->items[slot];
+    int operational = record->status == OPERATIONAL;
+    int type;
+
+    bitsetAssign(&store->operationalBits, slot, operational);
+    if (operational) heapPush(&store->operational, slot);
+    else heapRemove(&store->operational, slot);
+
+    for (type = 0; type < 3; type++) {
+        int matches = textMatchesType(record->type, (OccurrenceType) type) || textMatchesType(record->designation, (OccurrenceType) type);
+        bitsetAssign(&store->typeBits[type], slot, matches);
+        if (operational && matches) heapPush(&store->operationalFor[type], slot);
+        else heapRemove(&store->operationalFor[type], slot);
+    }
+}
+
+/**
+ * @brief Appends an equipment record to the store and indexes it by ID.
+ */
+Equipment* insertEquipment(EquipmentStore* store, const Equipment* record) {
+    if (!storeReserve((void**) &store->items, &store->capacity, &store->mappedSize, store->count + 1, sizeof(Equipment))) return NULL;
+    if (!idIndexPut(&store->index, record->id, store->count)) return NULL;
+    store->items[store->count] = *record;
+    store->statusCount[record->status]++;
+    trackAvailability(store, store->count);
+    return &store->items[store->count++];
+}
+
+/**
+ * @brief Replaces the equipment item with the same ID or appends it.
+ */
+Equipment* upsertEquipment(EquipmentStore* store, const Equipment* record) {
+    Equipment* existing = findEquipment(store, record->id);
+    if (!existing) return insertEquipment(store, record);
+
+    store->statusCount[existing->status]--;
+    *existing = *record;
+    store->statusCount[existing->status]++;
+    trackAvailability(store, (int) (existing - store->items));
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (existing - store->items));
+    return existing;
+}
+
+/**
+ * @brief Changes the status of an equipment item, keeping the counters current.
+ */
+void setEquipmentStatus(EquipmentStore* store, Equipment* record, EquipmentStatus status) {
+    store->statusCount[record->status]--;
+    record->status = status;
+    store->statusCount[status]++;
+}
+
+/**
+ * @brief Finds an equipment item by ID in constant time.
+ */
+Equipment* findEquipment(EquipmentStore* store, int id) {
+    int slot = idIndexGet(&store->index, id);
+    return slot < 0 ? NULL : &store->items[slot];
+}
+
+/**
+ * @brief Flags a modified equipment item for the next save and journals it.
+ */
+void touchEquipment(EquipmentStore* store, const Equipment* record) {
+    trackAvailability(store, (int) (record - store->items));
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (record - store->items));
+    journalAppend(JOURNAL_EQUIPMENT, record, sizeof(Equipment));
+}
+
+/**
+ * @brief Collects operational equipment (optionally of a type) from the bitsets.
+ */
+int collectOperationalEquipment(const EquipmentStore* store, int type, int limit, int* ids) {
+    int* slots = (int*) malloc(sizeof(int) * (limit > 0 ? limit : 1));
+    int n, i;
+    if (!slots) return 0;
+    n = bitsetCollectAnd(&store->operationalBits, type >= 0 ? &store->typeBits[type] : NULL, limit, slots);
+    for (i = 0; i < n; i++) ids[i] = store->items[slots[i]].id;
+    free(slots);
+    return n;
+}
+
+/**
+ * @brief Registers an equipment item from its fields (no user interaction).
  *
- * @param head Pointer to the current head of the linked list.
+ * @param store Pointer to the equipment store.
  * @param idSeq Pointer to the ID sequence counter.
- * @return Returns the new head of the linked list.
+ * @param designation Symbol of the designation.
+ * @param type Symbol of the type.
+ * @return Returns the new equipment item, or NULL if memory could not be allocated.
  */
-EquipmentNode* createEquipment(EquipmentNode* head, int* idSeq) {
-    EquipmentNode* newNode = (EquipmentNode*) malloc(sizeof(EquipmentNode));
-    if (!newNode) return head;
+Equipment* addEquipment(EquipmentStore* store, int* idSeq, Symbol designation, Symbol type) {
+    Equipment temp;
+    Equipment* created;
+
+    temp.id = *idSeq + 1;
+    temp.designation = designation;
+    temp.type = type;
+    temp.status = OPERATIONAL;
 
+    created = insertEquipment(store, &temp);
+    if (!created) return NULL;
     (*idSeq)++;
-    newNode->data.id = *idSeq;
+    touchEquipment(store, created);
+    return created;
+}
+
+/**
+ * @brief Creates a new equipment item and adds it to the store.
+ *
+ * @param store Pointer to the equipment store.
+ * @param idSeq Pointer to the ID sequence counter.
+ * @return Returns the new equipment item, or NULL if memory could not be allocated.
+ */
+Equipment* createEquipment(EquipmentStore* store, int* idSeq) {
+    Equipment* created;
+    char designation[MAX_STRING], type[MAX_STRING];
 
     cleanInputBuffer();
-    getString(newNode->data.designation, MAX_STRING, "Designação: ");
-    getString(newNode->data.type, MAX_STRING, "Tipo (ex: Mangueira): ");
+    getString(designation, MAX_STRING, "Designação: ");
+    getString(type, MAX_STRING, "Tipo (ex: Mangueira): ");
 
-    newNode->data.status = OPERATIONAL;
-    newNode->next = head;
+    created = addEquipment(store, idSeq, internString(designation), internString(type));
+    if (!created) return NULL;
 
     printf("Equipamento registado ID: %d\n", *idSeq);
-    return newNode;
+    return created;
 }
 
 /**
  * @brief Lists all available equipment.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the equipment store.
  */
-void listEquipments(EquipmentNode* head) {
-    if(!head) { printf("Sem equipamentos.\n"); return; }
+void listEquipments(const EquipmentStore* store) {
+    int i;
+    if(store->count == 0) { printf("Sem equipamentos.\n"); return; }
     printf("\n%-5s | %-20s | %-15s | %-10s\n", "ID", "DESIGNAÇÃO", "TIPO", "ESTADO");
-    EquipmentNode* current = head;
-    while (current) {
-        if (current->data.status != EQUIPMENT_INACTIVE) {
+    for (i = 0; i < store->count; i++) {
+        const Equipment* current = &store->items[i];
+        if (current->status != EQUIPMENT_INACTIVE) {
             printf("%-5d | %-20s | %-15s | %-10d\n",
-                   current->data.id, current->data.designation, current->data.type, current->data.status);
+                   current->id, symbolText(current->designation), symbolText(current->type), current->status);
         }
-        current = current->next;
     }
 }
 
+/**
+ * @brief Changes the status of an active equipment item by ID (no user interaction).
+ *
+ * @param store Pointer to the equipment store.
+ * @param id ID of the equipment item.
+ * @param status New status.
+ * @return Returns 1 on success, 0 if the item does not exist or is inactive.
+ */
+int changeEquipmentStatus(EquipmentStore* store, int id, EquipmentStatus status) {
+    Equipment* current = findEquipment(store, id);
+    if (!current || current->status == EQUIPMENT_INACTIVE) return 0;
+    setEquipmentStatus(store, current, status);
+    touchEquipment(store, current);
+    return 1;
+}
+
+/**
+ * @brief Soft-deletes an equipment item by ID (no user interaction).
+ *
+ * @param store Pointer to the equipment store.
+ * @param id ID of the equipment item.
+ * @return Returns 1 on success, 0 if the item does not exist.
+ */
+int removeEquipment(EquipmentStore* store, int id) {
+    Equipment* current = findEquipment(store, id);
+    if (!current) return 0;
+    setEquipmentStatus(store, current, EQUIPMENT_INACTIVE);
+    touchEquipment(store, current);
+    return 1;
+}
+
 /**
  * @brief Updates the status of an equipment item.
  *
- * @param head Pointer to the head of the linked list.
- */
-void updateEquipment(EquipmentNode* head) {
-    int id = getInt(1, 99999, "ID do Equipamento: ");
-    EquipmentNode* current = head;
-    while(current) {
-        if(current->data.id == id && current->data.status != EQUIPMENT_INACTIVE) {
-            printf("Novo Estado (0-Operacional, 1-Em Uso, 2-Manutenção): ");
-            int st = getInt(0, 2, "");
-            current->data.status = (EquipmentStatus)st;
-            printf("Estado atualizado.\n");
-            return;
-        }
-        current = current->next;
+ * @param store Pointer to the equipment store.
+ */
+void updateEquipment(EquipmentStore* store) {
+    int id = getInt(1, MAX_ID, "ID do Equipamento: ");
+    Equipment* current = findEquipment(store, id);
+    if(current && current->status != EQUIPMENT_INACTIVE) {
+        printf("Novo Estado (0-Operacional, 1-Em Uso, 2-Manutenção): ");
+        int st = getInt(0, 2, "");
+        changeEquipmentStatus(store, id, (EquipmentStatus) st);
+        printf("Estado atualizado.\n");
+        return;
     }
     printf("Equipamento não encontrado.\n");
 }
@@ -111,72 +262,83 @@ void updateEquipment(EquipmentNode* head) {
 /**
  * @brief Removes an equipment item (Soft delete).
  *
- * @param head Pointer to the head of the linked list.
- * @return Returns the head of the linked list.
- */
-EquipmentNode* deleteEquipment(EquipmentNode* head) {
-    int id = getInt(1, 99999, "ID a remover: ");
-    EquipmentNode* current = head;
-    while(current) {
-        if(current->data.id == id) {
-            current->data.status = EQUIPMENT_INACTIVE;
-            printf("Equipamento removido.\n");
-            return head;
-        }
-        current = current->next;
+ * @param store Pointer to the equipment store.
+ */
+void deleteEquipment(EquipmentStore* store) {
+    int id = getInt(1, MAX_ID, "ID a remover: ");
+    if(removeEquipment(store, id)) {
+        printf("Equipamento removido.\n");
+        return;
     }
     printf("ID não encontrado.\n");
-    return head;
 }
 
 /**
  * @brief Saves equipment data to a binary file.
  *
- * @param head Pointer to the head of the linked list.
- */
-void saveEquipments(EquipmentNode* head) {
-    FILE* fp = fopen(FILE_EQUIPMENTS, "wb");
-    if (!fp) return;
-    while(head){
-        fwrite(&head->data, sizeof(Equipment), 1, fp);
-        head = head->next;
-    }
-    fclose(fp);
+ * @param store Pointer to the equipment store.
+ */
+int saveEquipments(EquipmentStore* store) {
+    return storeFlush(FILE_EQUIPMENTS, EQUIPMENTS_MAGIC, EQUIPMENTS_VERSION, store->items, store->count, sizeof(Equipment), &store->dirty, &store->persistedCount);
+}
+
+/**
+ * @brief Accepts a loaded record only if its status can index statusCount.
+ */
+static int validEquipment(const void* record) {
+    int status = (int) ((const Equipment*) record)->status;
+    return status >= OPERATIONAL && status <= EQUIPMENT_INACTIVE;
 }
 
 /**
  * @brief Loads equipment data from a binary file.
  *
+ * Records are fixed-size, so the file is mapped (or read with a single fread) straight into the array.
+ *
+ * @param store Pointer to the store to fill.
  * @param idSeq Pointer to store the highest ID found.
- * @return Returns the pointer to the head of the loaded linked list.
  */
-EquipmentNode* loadEquipments(int* idSeq) {
-    FILE* fp = fopen(FILE_EQUIPMENTS, "rb");
-    if (!fp) return NULL;
-    EquipmentNode* head = NULL;
-    Equipment temp;
+void loadEquipments(EquipmentStore* store, int* idSeq) {
+    int i;
+
+    idIndexInit(&store->index);
+    for (i = 0; i < 4; i++) store->statusCount[i] = 0;
+    heapInit(&store->operational, lowerId, store);
+    bitsetInit(&store->operationalBits);
+    for (i = 0; i < 3; i++) {
+        heapInit(&store->operationalFor[i], lowerId, store);
+        bitsetInit(&store->typeBits[i]);
+    }
     *idSeq = 0;
-    while(fread(&temp, sizeof(Equipment), 1, fp)){
-        EquipmentNode* newNode = (EquipmentNode*)malloc(sizeof(EquipmentNode));
-        newNode->data = temp;
-        newNode->next = head;
-        head = newNode;
-        if(temp.id > *idSeq) *idSeq = temp.id;
+    storeLoad(FILE_EQUIPMENTS, EQUIPMENTS_MAGIC, EQUIPMENTS_VERSION, (void**) &store->items, &store->count, &store->capacity,
+              &store->mappedSize, sizeof(Equipment), validEquipment);
+    store->persistedCount = store->count;
+    store->dirty = (unsigned char*) calloc(store->count > 0 ? store->count : 1, 1);
+
+    for (i = 0; i < store->count; i++) {
+        idIndexPut(&store->index, store->items[i].id, i);
+        store->statusCount[store->items[i].status]++;
+        trackAvailability(store, i);
+        if (store->items[i].id > *idSeq) *idSeq = store->items[i].id;
     }
-    fclose(fp);
-    return head;
 }
 
 /**
  * @brief Frees memory allocated for equipment.
  *
- * @param head Pointer to the head of the linked list.
- */
-void freeEquipments(EquipmentNode* head) {
-    EquipmentNode* temp;
-    while(head){
-        temp = head;
-        head = head->next;
-        free(temp);
+ * @param store Pointer to the equipment store.
+ */
+void freeEquipments(EquipmentStore* store) {
+    int i;
+    storeRelease((void**) &store->items, &store->count, &store->capacity, &store->mappedSize);
+    free(store->dirty);
+    store->dirty = NULL;
+    store->persistedCount = 0;
+    idIndexFree(&store->index);
+    heapFree(&store->operational);
+    bitsetFree(&store->operationalBits);
+    for (i = 0; i < 3; i++) {
+        heapFree(&store->operationalFor[i]);
+        bitsetFree(&store->typeBits[i]);
     }
-}
\ No newline at end of file
+}
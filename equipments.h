@@ -17,62 +17,157 @@
 /**
  * @brief Displays the Equipment management menu.
  *
- * @param head Double pointer to the head of the linked list.
+ * @param store Pointer to the equipment store.
  * @param idSeq Pointer to the ID sequence counter.
  */
-void menuEquipments(EquipmentNode** head, int* idSeq);
+void menuEquipments(EquipmentStore* store, int* idSeq);
 
 /**
- * @brief Creates a new equipment item and adds it to the list.
+ * @brief Registers a new equipment item (OPERATIONAL) from its fields, without user interaction.
  *
- * @param head Pointer to the current head of the linked list.
+ * @param store Pointer to the equipment store.
  * @param idSeq Pointer to the ID sequence counter.
- * @return Returns the new head of the linked list.
+ * @param designation Symbol of the designation.
+ * @param type Symbol of the type.
+ * @return Returns the new equipment item, or NULL if memory could not be allocated.
  */
-EquipmentNode* createEquipment(EquipmentNode* head, int* idSeq);
+Equipment* addEquipment(EquipmentStore* store, int* idSeq, Symbol designation, Symbol type);
+
+/**
+ * @brief Creates a new equipment item and adds it to the store.
+ *
+ * @param store Pointer to the equipment store.
+ * @param idSeq Pointer to the ID sequence counter.
+ * @return Returns the new equipment item, or NULL if memory could not be allocated.
+ */
+Equipment* createEquipment(EquipmentStore* store, int* idSeq);
+
+/**
+ * @brief Appends an equipment record to the store and indexes it by ID.
+ *
+ * @param store Pointer to the equipment store.
+ * @param record Record to copy into the store.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Equipment* insertEquipment(EquipmentStore* store, const Equipment* record);
+
+/**
+ * @brief Stores a new version of a record: replaces the record with the same ID or appends it.
+ *
+ * Used when replaying the journal; keeps every structure derived from the store up to date.
+ *
+ * @param store Pointer to the equipment store.
+ * @param record New version of the record.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Equipment* upsertEquipment(EquipmentStore* store, const Equipment* record);
+
+/**
+ * @brief Changes the status of an equipment item, keeping the per-status counters current.
+ *
+ * @param store Pointer to the equipment store.
+ * @param record Pointer to the equipment item (inside the store).
+ * @param status New status.
+ */
+void setEquipmentStatus(EquipmentStore* store, Equipment* record, EquipmentStatus status);
+
+/**
+ * @brief Collects the IDs of OPERATIONAL equipment, optionally only those suited to an occurrence type.
+ *
+ * Reads the operational and type bitsets of the store: one word-wide AND per 64 items.
+ *
+ * @param store Pointer to the equipment store.
+ * @param type OccurrenceType the equipment must suit, or -1 for any equipment.
+ * @param limit Maximum number of IDs to collect.
+ * @param ids Array with room for limit IDs.
+ * @return Returns the number of IDs written.
+ */
+int collectOperationalEquipment(const EquipmentStore* store, int type, int limit, int* ids);
+
+/**
+ * @brief Records that an equipment item was modified: flags it for the next save and journals it.
+ *
+ * Must be called after every change to a record already in the store. It also adds or removes
+ * the item from the operational queues used by the dispatch recommendations.
+ *
+ * @param store Pointer to the equipment store.
+ * @param record Pointer to the modified record (inside the store).
+ */
+void touchEquipment(EquipmentStore* store, const Equipment* record);
 
 /**
  * @brief Lists all available equipment.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the equipment store.
+ */
+void listEquipments(const EquipmentStore* store);
+
+/**
+ * @brief Changes the status of an active equipment item, without user interaction.
+ *
+ * @param store Pointer to the equipment store.
+ * @param id ID of the equipment item.
+ * @param status New status.
+ * @return Returns 1 on success, 0 if the item does not exist or is inactive.
+ */
+int changeEquipmentStatus(EquipmentStore* store, int id, EquipmentStatus status);
+
+/**
+ * @brief Removes an equipment item (soft delete), without user interaction.
+ *
+ * @param store Pointer to the equipment store.
+ * @param id ID of the equipment item.
+ * @return Returns 1 on success, 0 if the item does not exist.
  */
-void listEquipments(EquipmentNode* head);
+int removeEquipment(EquipmentStore* store, int id);
 
 /**
  * @brief Updates the status of an equipment item.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the equipment store.
  */
-void updateEquipment(EquipmentNode* head);
+void updateEquipment(EquipmentStore* store);
 
 /**
  * @brief Removes an equipment item (Soft delete).
  *
- * @param head Pointer to the head of the linked list.
- * @return Returns the head of the linked list.
+ * @param store Pointer to the equipment store.
  */
-EquipmentNode* deleteEquipment(EquipmentNode* head);
+void deleteEquipment(EquipmentStore* store);
 
 /**
  * @brief Saves equipment data to a binary file.
  *
- * @param head Pointer to the head of the linked list.
+ * Only records changed since the last save are rewritten (in place); new records are appended.
+ *
+ * @param store Pointer to the equipment store.
+ * @return Returns 1 on success, 0 if the file could not be written.
  */
-void saveEquipments(EquipmentNode* head);
+int saveEquipments(EquipmentStore* store);
 
 /**
  * @brief Loads equipment data from a binary file.
  *
+ * @param store Pointer to the store to fill (always initialized, even if the file does not exist).
  * @param idSeq Pointer to store the highest ID found.
- * @return Returns the pointer to the head of the loaded linked list.
  */
-EquipmentNode* loadEquipments(int* idSeq);
+void loadEquipments(EquipmentStore* store, int* idSeq);
+
+/**
+ * @brief Finds an equipment item by ID using the hash index (constant time).
+ *
+ * @param store Pointer to the equipment store.
+ * @param id ID of the equipment item to find.
+ * @return Returns the equipment item, or NULL if the ID does not exist.
+ * @note The pointer is only valid until the next insertion into the store.
+ */
+Equipment* findEquipment(EquipmentStore* store, int id);
 
 /**
  * @brief Frees memory allocated for equipment.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the equipment store.
  */
-void freeEquipments(EquipmentNode* head);
+void freeEquipments(EquipmentStore* store);
 
-#endif // EQUIPMENTS_H
\ No newline at end of file
+#endif // EQUIPMENTS_H
@@ -13,12 +13,19 @@
 #include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
 
 #include "firefighters.h"
+#include "occurrences.h"
+#include "store.h"
+#include "journal.h"
+#include "symbols.h"
 #include "input.h"
 
+#define FIREFIGHTERS_MAGIC 0x52494646 // "FFIR"
+#define FIREFIGHTERS_VERSION 1
+
 /**
  * @brief Displays the Firefighter management menu.
  */
-void menuFirefighters(FirefighterNode** head, int* idSeq) {
+void menuFirefighters(FirefighterStore* store, int* idSeq) {
     int op;
     do {
         printf("\n--- GESTÃO DE BOMBEIROS ---\n");
@@ -31,80 +38,212 @@ void menuFirefighters(FirefighterNode** head, int* idSeq) {
         op = getInt(0, 5, "Opção: ");
         switch (op) {
             case 1:
-                *head = createFirefighter(*head, idSeq);
+                createFirefighter(store, idSeq);
             break;
             case 2:
-                listFirefighters(*head);
+                listFirefighters(store);
             break;
             case 3:
-                updateFirefighter(*head);
+                updateFirefighter(store);
             break;
             case 4:
-                *head = deleteFirefighter(*head);
+                deleteFirefighter(store);
             break;
             case 5:
-                listFirefighterRanking(*head);
+                listFirefighterRanking(store);
             break;
         }
     } while (op != 0);
 }
 
 /**
- * @brief Creates a new firefighter.
+ * @brief Heap order of the availability queues: fewest interventions first, then lowest ID.
+ */
+static int lessLoaded(const void* context, int a, int b) {
+    const Firefighter* items = ((const FirefighterStore*) context)->items;
+    if (items[a].totalInterventions != items[b].totalInterventions) {
+        return items[a].totalInterventions < items[b].totalInterventions;
+    }
+    return items[a].id < items[b].id;
+}
+
+/**
+ * @brief Puts a firefighter in (or takes it out of) the availability queues after a change.
+ */
+static void trackAvailability(FirefighterStore* store, int slot) {
+    const Firefighter* record = &store->items[slot];
+    int available = record->status == AVAILABLE;
+    int type;
+
+    bitsetAssign(&store->availableBits, slot, available);
+    if (available) heapPush(&store->available, slot);
+    else heapRemove(&store->available, slot);
+
+    for (type = 0; type < 3; type++) {
+        int matches = textMatchesType(record->specialty, (OccurrenceType) type);
+        bitsetAssign(&store->specialtyBits[type], slot, matches);
+        if (available && matches) heapPush(&store->availableFor[type], slot);
+        else heapRemove(&store->availableFor[type], slot);
+    }
+}
+
+/**
+ * @brief Appends a firefighter record to the store and indexes it by ID.
+ */
+Firefighter* insertFirefighter(FirefighterStore* store, const Firefighter* record) {
+    if (!storeReserve((void**) &store->items, &store->capacity, &store->mappedSize, store->count + 1, sizeof(Firefighter))) return NULL;
+    if (!idIndexPut(&store->index, record->id, store->count)) return NULL;
+    store->items[store->count] = *record;
+    store->statusCount[record->status]++;
+    trackAvailability(store, store->count);
+    return &store->items[store->count++];
+}
+
+/**
+ * @brief Replaces the firefighter with the same ID or appends it.
  */
-FirefighterNode* createFirefighter(FirefighterNode* head, int* idSeq) {
-    FirefighterNode* newNode = (FirefighterNode*) malloc(sizeof(FirefighterNode));
-    if (!newNode) return head;
+Firefighter* upsertFirefighter(FirefighterStore* store, const Firefighter* record) {
+    Firefighter* existing = findFirefighter(store, record->id);
+    if (!existing) return insertFirefighter(store, record);
+
+    store->statusCount[existing->status]--;
+    *existing = *record;
+    store->statusCount[existing->status]++;
+    trackAvailability(store, (int) (existing - store->items));
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (existing - store->items));
+    return existing;
+}
+
+/**
+ * @brief Changes the status of a firefighter, keeping the counters current.
+ */
+void setFirefighterStatus(FirefighterStore* store, Firefighter* record, FirefighterStatus status) {
+    store->statusCount[record->status]--;
+    record->status = status;
+    store->statusCount[status]++;
+}
+
+/**
+ * @brief Finds a firefighter by ID in constant time.
+ */
+Firefighter* findFirefighter(FirefighterStore* store, int id) {
+    int slot = idIndexGet(&store->index, id);
+    return slot < 0 ? NULL : &store->items[slot];
+}
+
+/**
+ * @brief Flags a modified firefighter for the next save and journals it.
+ */
+void touchFirefighter(FirefighterStore* store, const Firefighter* record) {
+    trackAvailability(store, (int) (record - store->items));
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (record - store->items));
+    journalAppend(JOURNAL_FIREFIGHTER, record, sizeof(Firefighter));
+}
+
+/**
+ * @brief Collects available firefighters (optionally of a specialty) from the bitsets.
+ */
+int collectAvailableFirefighters(const FirefighterStore* store, int type, int limit, int* ids) {
+    int* slots = (int*) malloc(sizeof(int) * (limit > 0 ? limit : 1));
+    int n, i;
+    if (!slots) return 0;
+    n = bitsetCollectAnd(&store->availableBits, type >= 0 ? &store->specialtyBits[type] : NULL, limit, slots);
+    for (i = 0; i < n; i++) ids[i] = store->items[slots[i]].id;
+    free(slots);
+    return n;
+}
 
+/**
+ * @brief Registers a firefighter from its fields (no user interaction).
+ */
+Firefighter* addFirefighter(FirefighterStore* store, int* idSeq, Symbol name, Symbol specialty) {
+    Firefighter temp;
+    Firefighter* created;
+
+    temp.id = *idSeq + 1;
+    temp.name = name;
+    temp.specialty = specialty;
+    temp.status = AVAILABLE;
+    temp.totalInterventions = 0;
+    temp.totalResponseTime = 0;
+
+    created = insertFirefighter(store, &temp);
+    if (!created) return NULL;
     (*idSeq)++;
-    newNode->data.id = *idSeq;
+    touchFirefighter(store, created);
+    return created;
+}
+
+/**
+ * @brief Creates a new firefighter.
+ */
+Firefighter* createFirefighter(FirefighterStore* store, int* idSeq) {
+    Firefighter* created;
+    char name[MAX_STRING], specialty[MAX_STRING];
 
     cleanInputBuffer();
-    getString(newNode->data.name, MAX_STRING, "Nome do Bombeiro: ");
-    getString(newNode->data.specialty, MAX_STRING, "Especialidade: ");
+    getString(name, MAX_STRING, "Nome do Bombeiro: ");
+    getString(specialty, MAX_STRING, "Especialidade: ");
 
-    newNode->data.status = AVAILABLE;
-    newNode->data.totalInterventions = 0;
-    newNode->data.totalResponseTime = 0;
-    newNode->next = head;
+    created = addFirefighter(store, idSeq, internString(name), internString(specialty));
+    if (!created) return NULL;
 
     printf("Bombeiro criado com ID %d.\n", *idSeq);
-    return newNode;
+    return created;
 }
 
 /**
  * @brief Lists all active firefighters.
  */
-void listFirefighters(FirefighterNode* head) {
-    if (!head) { printf("Nenhum bombeiro registado.\n"); return; }
+void listFirefighters(const FirefighterStore* store) {
+    int i;
+    if (store->count == 0) { printf("Nenhum bombeiro registado.\n"); return; }
     printf("\n%-5s | %-30s | %-20s | %-10s | %-5s\n", "ID", "NOME", "ESPECIALIDADE", "ESTADO", "INTERVENÇÕES");
-    FirefighterNode* current = head;
-    while (current) {
-        if (current->data.status != FIREFIGHTER_INACTIVE) {
+    for (i = 0; i < store->count; i++) {
+        const Firefighter* current = &store->items[i];
+        if (current->status != FIREFIGHTER_INACTIVE) {
             printf("%-5d | %-30s | %-20s | %-10d | %-5d\n",
-                   current->data.id, current->data.name, current->data.specialty, current->data.status, current->data.totalInterventions);
+                   current->id, symbolText(current->name), symbolText(current->specialty), current->status, current->totalInterventions);
         }
-        current = current->next;
     }
 }
 
+/**
+ * @brief Changes the status of an active firefighter by ID (no user interaction).
+ */
+int changeFirefighterStatus(FirefighterStore* store, int id, FirefighterStatus status) {
+    Firefighter* current = findFirefighter(store, id);
+    if (!current || current->status == FIREFIGHTER_INACTIVE) return 0;
+    setFirefighterStatus(store, current, status);
+    touchFirefighter(store, current);
+    return 1;
+}
+
+/**
+ * @brief Soft-deletes a firefighter by ID (no user interaction).
+ */
+int removeFirefighter(FirefighterStore* store, int id) {
+    Firefighter* current = findFirefighter(store, id);
+    if (!current) return 0;
+    setFirefighterStatus(store, current, FIREFIGHTER_INACTIVE);
+    touchFirefighter(store, current);
+    return 1;
+}
+
 /**
  * @brief Updates the status of an existing firefighter.
  *
- * @param head Pointer to the head of the linked list.
- */
-void updateFirefighter(FirefighterNode* head) {
-    int id = getInt(1, 99999, "ID do Bombeiro a editar: ");
-    FirefighterNode* current = head;
-    while (current) {
-        if (current->data.id == id && current->data.status != FIREFIGHTER_INACTIVE) {
-            printf("Novo Estado (0-Disp, 1-Ocup, 2-Inat): ");
-            int st = getInt(0, 2, "");
-            current->data.status = (FirefighterStatus) st;
-            printf("Estado atualizado.\n");
-            return;
-        }
-        current = current->next;
+ * @param store Pointer to the firefighter store.
+ */
+void updateFirefighter(FirefighterStore* store) {
+    int id = getInt(1, MAX_ID, "ID do Bombeiro a editar: ");
+    Firefighter* current = findFirefighter(store, id);
+    if (current && current->status != FIREFIGHTER_INACTIVE) {
+        printf("Novo Estado (0-Disp, 1-Ocup, 2-Inat): ");
+        int st = getInt(0, 2, "");
+        changeFirefighterStatus(store, id, (FirefighterStatus) st);
+        printf("Estado atualizado.\n");
+        return;
     }
     printf("Bombeiro não encontrado.\n");
 }
@@ -112,89 +251,99 @@ void updateFirefighter(FirefighterNode* head) {
 /**
  * @brief Performs a soft delete on a firefighter (sets state to INACTIVE).
  *
- * @param head Pointer to the head of the linked list.
- * @return Returns the head of the linked list.
- */
-FirefighterNode* deleteFirefighter(FirefighterNode* head) {
-    int id = getInt(1, 99999, "ID do Bombeiro a remover: ");
-    FirefighterNode* current = head;
-    while (current) {
-        if (current->data.id == id) {
-            current->data.status = FIREFIGHTER_INACTIVE;
-            printf("Bombeiro removido (Inativo).\n");
-            return head;
-        }
-        current = current->next;
+ * @param store Pointer to the firefighter store.
+ */
+void deleteFirefighter(FirefighterStore* store) {
+    int id = getInt(1, MAX_ID, "ID do Bombeiro a remover: ");
+    if (removeFirefighter(store, id)) {
+        printf("Bombeiro removido (Inativo).\n");
+        return;
     }
     printf("Bombeiro não encontrado.\n");
-    return head;
 }
 
 /**
  * @brief REPORT: Ranking based on completed interventions.
 */
-void listFirefighterRanking(FirefighterNode* head) {
+void listFirefighterRanking(const FirefighterStore* store) {
+    int i;
     printf("\n=== RANKING DE DESEMPENHO (BOMBEIROS) ===\n");
     printf("%-30s | %-15s\n", "NOME", "INTERVENÇÕES");
     printf("------------------------------------------------\n");
 
-    while(head) {
-        if(head->data.status != FIREFIGHTER_INACTIVE) {
-            printf("%-30s | %d concluídas\n", head->data.name, head->data.totalInterventions);
+    for (i = 0; i < store->count; i++) {
+        if (store->items[i].status != FIREFIGHTER_INACTIVE) {
+            printf("%-30s | %d concluídas\n", symbolText(store->items[i].name), store->items[i].totalInterventions);
         }
-        head = head->next;
     }
 }
 
 /**
- * @brief Saves the firefighter list to a binary file.
+ * @brief Saves the firefighter store to a binary file.
  *
- * @param head Pointer to the head of the linked list.
- */
-void saveFirefighters(FirefighterNode* head) {
-    FILE* fp = fopen(FILE_FIREFIGHTERS, "wb");
-    if (!fp) return;
-    while(head) {
-        fwrite(&head->data, sizeof(Firefighter), 1, fp);
-        head = head->next;
-    }
-    fclose(fp);
+ * @param store Pointer to the firefighter store.
+ */
+int saveFirefighters(FirefighterStore* store) {
+    return storeFlush(FILE_FIREFIGHTERS, FIREFIGHTERS_MAGIC, FIREFIGHTERS_VERSION, store->items, store->count, sizeof(Firefighter), &store->dirty, &store->persistedCount);
 }
 
 /**
- * @brief Loads the firefighter list from a binary file.
+ * @brief Accepts a loaded record only if its status can index statusCount.
+ */
+static int validFirefighter(const void* record) {
+    int status = (int) ((const Firefighter*) record)->status;
+    return status >= AVAILABLE && status <= FIREFIGHTER_INACTIVE;
+}
+
+/**
+ * @brief Loads the firefighter store from a binary file.
+ *
+ * Records are fixed-size, so the file is mapped (or read with a single fread) straight into the array.
  *
+ * @param store Pointer to the store to fill.
  * @param idSeq Pointer to store the highest ID found (to resume sequencing).
- * @return Returns the pointer to the head of the loaded linked list.
  */
-FirefighterNode* loadFirefighters(int* idSeq) {
-    FILE* fp = fopen(FILE_FIREFIGHTERS, "rb");
-    if (!fp) return NULL;
-    FirefighterNode* head = NULL;
-    Firefighter temp;
+void loadFirefighters(FirefighterStore* store, int* idSeq) {
+    int i;
+
+    idIndexInit(&store->index);
+    heapInit(&store->available, lessLoaded, store);
+    bitsetInit(&store->availableBits);
+    for (i = 0; i < 3; i++) {
+        store->statusCount[i] = 0;
+        heapInit(&store->availableFor[i], lessLoaded, store);
+        bitsetInit(&store->specialtyBits[i]);
+    }
     *idSeq = 0;
-    while(fread(&temp, sizeof(Firefighter), 1, fp)){
-        FirefighterNode* newNode = (FirefighterNode*)malloc(sizeof(FirefighterNode));
-        if (!newNode) break;
-        newNode->data = temp;
-        newNode->next = head;
-        head = newNode;
-        if(temp.id > *idSeq) *idSeq = temp.id;
+    storeLoad(FILE_FIREFIGHTERS, FIREFIGHTERS_MAGIC, FIREFIGHTERS_VERSION, (void**) &store->items, &store->count, &store->capacity,
+              &store->mappedSize, sizeof(Firefighter), validFirefighter);
+    store->persistedCount = store->count;
+    store->dirty = (unsigned char*) calloc(store->count > 0 ? store->count : 1, 1);
+
+    for (i = 0; i < store->count; i++) {
+        idIndexPut(&store->index, store->items[i].id, i);
+        store->statusCount[store->items[i].status]++;
+        trackAvailability(store, i);
+        if (store->items[i].id > *idSeq) *idSeq = store->items[i].id;
     }
-    fclose(fp);
-    return head;
 }
 
 /**
- * @brief Frees all memory allocated for the firefighter list.
+ * @brief Frees all memory allocated for the firefighter store.
  *
- * @param head Pointer to the head of the linked list.
- */
-void freeFirefighters(FirefighterNode* head) {
-    FirefighterNode* temp;
-    while(head){
-        temp = head;
-        head = head->next;
-        free(temp);
+ * @param store Pointer to the firefighter store.
+ */
+void freeFirefighters(FirefighterStore* store) {
+    int i;
+    storeRelease((void**) &store->items, &store->count, &store->capacity, &store->mappedSize);
+    free(store->dirty);
+    store->dirty = NULL;
+    store->persistedCount = 0;
+    idIndexFree(&store->index);
+    heapFree(&store->available);
+    bitsetFree(&store->availableBits);
+    for (i = 0; i < 3; i++) {
+        heapFree(&store->availableFor[i]);
+        bitsetFree(&store->specialtyBits[i]);
     }
-}
\ No newline at end of file
+}
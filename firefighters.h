@@ -17,68 +17,163 @@
 /**
  * @brief Displays the Firefighter management menu and handles user selection.
  *
- * @param head Double pointer to the head of the linked list (to allow modification).
+ * @param store Pointer to the firefighter store.
  * @param idSeq Pointer to the ID sequence counter.
  */
-void menuFirefighters(FirefighterNode** head, int* idSeq);
+void menuFirefighters(FirefighterStore* store, int* idSeq);
 
 /**
- * @brief Creates a new firefighter and adds it to the list.
+ * @brief Registers a new firefighter (AVAILABLE, no interventions) from its fields, without user interaction.
  *
- * @param head Pointer to the current head of the linked list.
+ * @param store Pointer to the firefighter store.
  * @param idSeq Pointer to the ID sequence counter to generate a new unique ID.
- * @return Returns the new head of the linked list.
+ * @param name Symbol of the name.
+ * @param specialty Symbol of the specialty.
+ * @return Returns the new firefighter, or NULL if memory could not be allocated.
  */
-FirefighterNode* createFirefighter(FirefighterNode* head, int* idSeq);
+Firefighter* addFirefighter(FirefighterStore* store, int* idSeq, Symbol name, Symbol specialty);
+
+/**
+ * @brief Creates a new firefighter and adds it to the store.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param idSeq Pointer to the ID sequence counter to generate a new unique ID.
+ * @return Returns the new firefighter, or NULL if memory could not be allocated.
+ */
+Firefighter* createFirefighter(FirefighterStore* store, int* idSeq);
+
+/**
+ * @brief Appends a firefighter record to the store and indexes it by ID.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param record Record to copy into the store.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Firefighter* insertFirefighter(FirefighterStore* store, const Firefighter* record);
+
+/**
+ * @brief Stores a new version of a record: replaces the record with the same ID or appends it.
+ *
+ * Used when replaying the journal; keeps every structure derived from the store up to date.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param record New version of the record.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Firefighter* upsertFirefighter(FirefighterStore* store, const Firefighter* record);
+
+/**
+ * @brief Changes the status of a firefighter, keeping the per-status counters current.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param record Pointer to the firefighter (inside the store).
+ * @param status New status.
+ */
+void setFirefighterStatus(FirefighterStore* store, Firefighter* record, FirefighterStatus status);
+
+/**
+ * @brief Collects the IDs of AVAILABLE firefighters, optionally only those of a specialty.
+ *
+ * Reads the availability and specialty bitsets of the store: one word-wide AND per 64 firefighters.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param type OccurrenceType the specialty must match, or -1 for any specialty.
+ * @param limit Maximum number of IDs to collect.
+ * @param ids Array with room for limit IDs.
+ * @return Returns the number of IDs written.
+ */
+int collectAvailableFirefighters(const FirefighterStore* store, int type, int limit, int* ids);
+
+/**
+ * @brief Records that a firefighter was modified: flags it for the next save and journals it.
+ *
+ * Must be called after every change to a record already in the store. It also repositions the
+ * firefighter in the availability queues, whose order depends on its status and load.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param record Pointer to the modified record (inside the store).
+ */
+void touchFirefighter(FirefighterStore* store, const Firefighter* record);
 
 /**
  * @brief Lists all active firefighters in the console.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the firefighter store.
+ */
+void listFirefighters(const FirefighterStore* store);
+
+/**
+ * @brief Changes the status of an active firefighter, without user interaction.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param id ID of the firefighter.
+ * @param status New status.
+ * @return Returns 1 on success, 0 if the firefighter does not exist or is inactive.
+ */
+int changeFirefighterStatus(FirefighterStore* store, int id, FirefighterStatus status);
+
+/**
+ * @brief Performs a soft delete on a firefighter, without user interaction.
+ *
+ * @param store Pointer to the firefighter store.
+ * @param id ID of the firefighter.
+ * @return Returns 1 on success, 0 if the firefighter does not exist.
  */
-void listFirefighters(FirefighterNode* head);
+int removeFirefighter(FirefighterStore* store, int id);
 
 /**
  * @brief Updates the status of an existing firefighter.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the firefighter store.
  */
-void updateFirefighter(FirefighterNode* head);
+void updateFirefighter(FirefighterStore* store);
 
 /**
  * @brief Performs a soft delete on a firefighter (sets state to INACTIVE).
  *
- * @param head Pointer to the head of the linked list.
- * @return Returns the head of the linked list.
+ * @param store Pointer to the firefighter store.
  */
-FirefighterNode* deleteFirefighter(FirefighterNode* head);
+void deleteFirefighter(FirefighterStore* store);
 
 /**
- * @brief Saves the firefighter list to a binary file.
+ * @brief Saves the firefighter store to a binary file.
  *
- * @param head Pointer to the head of the linked list.
+ * Only records changed since the last save are rewritten (in place); new records are appended.
+ *
+ * @param store Pointer to the firefighter store.
+ * @return Returns 1 on success, 0 if the file could not be written.
  */
-void saveFirefighters(FirefighterNode* head);
+int saveFirefighters(FirefighterStore* store);
 
 /**
- * @brief Loads the firefighter list from a binary file.
+ * @brief Loads the firefighter store from a binary file.
  *
+ * @param store Pointer to the store to fill (always initialized, even if the file does not exist).
  * @param idSeq Pointer to store the highest ID found (to resume sequencing).
- * @return Returns the pointer to the head of the loaded linked list.
  */
-FirefighterNode* loadFirefighters(int* idSeq);
+void loadFirefighters(FirefighterStore* store, int* idSeq);
+
+/**
+ * @brief Finds a firefighter by ID using the hash index (constant time).
+ *
+ * @param store Pointer to the firefighter store.
+ * @param id ID of the firefighter to find.
+ * @return Returns the firefighter, or NULL if the ID does not exist.
+ * @note The pointer is only valid until the next insertion into the store.
+ */
+Firefighter* findFirefighter(FirefighterStore* store, int id);
 
 /**
- * @brief Frees all memory allocated for the firefighter list.
+ * @brief Frees all memory allocated for the firefighter store.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the firefighter store.
  */
-void freeFirefighters(FirefighterNode* head);
+void freeFirefighters(FirefighterStore* store);
 
 /**
  * @brief Lists firefighters ranked by the number of interventions.
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the firefighter store.
  */
-void listFirefighterRanking(FirefighterNode* head);
+void listFirefighterRanking(const FirefighterStore* store);
 
-#endif // FIREFIGHTERS_H
\ No newline at end of file
+#endif // FIREFIGHTERS_H
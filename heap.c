@@ -0,0 +1,196 @@
+/**
+ * @file heap.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the indexed binary heap.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+
+#include "heap.h"
+#include "store.h"
+
+/**
+ * @brief Places a slot at a position of the heap array, updating its recorded position.
+ */
+static void place(Heap* heap, int pos, int slot) {
+    heap->items[pos] = slot;
+    heap->position[slot] = pos;
+}
+
+/**
+ * @brief Moves the slot at a position up while it comes before its parent.
+ */
+static void siftUp(Heap* heap, int pos) {
+    int slot = heap->items[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!heap->before(heap->context, slot, heap->items[parent])) break;
+        place(heap, pos, heap->items[parent]);
+        pos = parent;
+    }
+    place(heap, pos, slot);
+}
+
+/**
+ * @brief Moves the slot at a position down while one of its children comes before it.
+ */
+static void siftDown(Heap* heap, int pos) {
+    int slot = heap->items[pos];
+    for (;;) {
+        int child = 2 * pos + 1;
+        if (child >= heap->count) break;
+        if (child + 1 < heap->count && heap->before(heap->context, heap->items[child + 1], heap->items[child])) child++;
+        if (!heap->before(heap->context, heap->items[child], slot)) break;
+        place(heap, pos, heap->items[child]);
+        pos = child;
+    }
+    place(heap, pos, slot);
+}
+
+/**
+ * @brief Initializes an empty heap.
+ */
+void heapInit(Heap* heap, HeapBefore before, const void* context) {
+    heap->items = NULL;
+    heap->count = 0;
+    heap->capacity = 0;
+    heap->position = NULL;
+    heap->positionCapacity = 0;
+    heap->before = before;
+    heap->context = context;
+}
+
+/**
+ * @brief Tells whether a slot is in the heap.
+ */
+int heapContains(const Heap* heap, int slot) {
+    return slot >= 0 && slot < heap->positionCapacity && heap->position[slot] >= 0;
+}
+
+/**
+ * @brief Adds a slot, or repositions it if it is already in the heap.
+ */
+int heapPush(Heap* heap, int slot) {
+    int oldCapacity = heap->positionCapacity;
+    int i;
+
+    if (heapContains(heap, slot)) {
+        heapUpdate(heap, slot);
+        return 1;
+    }
+    if (!storeReserve((void**) &heap->position, &heap->positionCapacity, NULL, slot + 1, sizeof(int))) return 0;
+    for (i = oldCapacity; i < heap->positionCapacity; i++) heap->position[i] = -1;
+    if (!storeReserve((void**) &heap->items, &heap->capacity, NULL, heap->count + 1, sizeof(int))) return 0;
+
+    heap->count++;
+    place(heap, heap->count - 1, slot);
+    siftUp(heap, heap->count - 1);
+    return 1;
+}
+
+/**
+ * @brief Returns the first slot without removing it.
+ */
+int heapPeek(const Heap* heap) {
+    return heap->count > 0 ? heap->items[0] : -1;
+}
+
+/**
+ * @brief Removes and returns the first slot.
+ */
+int heapPop(Heap* heap) {
+    int slot = heapPeek(heap);
+    if (slot >= 0) heapRemove(heap, slot);
+    return slot;
+}
+
+/**
+ * @brief Removes a slot from the heap.
+ */
+void heapRemove(Heap* heap, int slot) {
+    int pos, last;
+    if (!heapContains(heap, slot)) return;
+
+    pos = heap->position[slot];
+    heap->position[slot] = -1;
+    heap->count--;
+    if (pos == heap->count) return;
+
+    // Fill the hole with the last slot and restore the order around it.
+    last = heap->items[heap->count];
+    place(heap, pos, last);
+    siftUp(heap, pos);
+    siftDown(heap, heap->position[last]);
+}
+
+/**
+ * @brief Repositions a slot after its key changed.
+ */
+void heapUpdate(Heap* heap, int slot) {
+    if (!heapContains(heap, slot)) return;
+    siftUp(heap, heap->position[slot]);
+    siftDown(heap, heap->position[slot]);
+}
+
+/**
+ * @brief Returns the first k slots in order, without modifying the heap.
+ *
+ * Walks the heap best-first with a small auxiliary heap of candidate positions: the next slot
+ * in order is always the best candidate, and its children become candidates.
+ */
+int heapFirst(const Heap* heap, int k, int* out) {
+    int* candidates;
+    int n = 0, found = 0;
+
+    if (k <= 0 || heap->count == 0) return 0;
+    candidates = (int*) malloc(sizeof(int) * (2 * k + 1));
+    if (!candidates) return 0;
+
+    candidates[n++] = 0;
+    while (n > 0 && found < k) {
+        int best = candidates[0];
+        int child, i, pos;
+
+        // Pop the best candidate position.
+        candidates[0] = candidates[--n];
+        for (pos = 0;;) {
+            int c = 2 * pos + 1, tmp;
+            if (c >= n) break;
+            if (c + 1 < n && heap->before(heap->context, heap->items[candidates[c + 1]], heap->items[candidates[c]])) c++;
+            if (!heap->before(heap->context, heap->items[candidates[c]], heap->items[candidates[pos]])) break;
+            tmp = candidates[c]; candidates[c] = candidates[pos]; candidates[pos] = tmp;
+            pos = c;
+        }
+
+        out[found++] = heap->items[best];
+
+        // Its children in the heap become candidates.
+        for (child = 2 * best + 1; child <= 2 * best + 2 && child < heap->count; child++) {
+            i = n++;
+            candidates[i] = child;
+            while (i > 0 && heap->before(heap->context, heap->items[candidates[i]], heap->items[candidates[(i - 1) / 2]])) {
+                int tmp = candidates[i];
+                candidates[i] = candidates[(i - 1) / 2];
+                candidates[(i - 1) / 2] = tmp;
+                i = (i - 1) / 2;
+            }
+        }
+    }
+
+    free(candidates);
+    return found;
+}
+
+/**
+ * @brief Frees all memory used by the heap.
+ */
+void heapFree(Heap* heap) {
+    free(heap->items);
+    free(heap->position);
+    heapInit(heap, heap->before, heap->context);
+}
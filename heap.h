@@ -0,0 +1,112 @@
+/**
+ * @file heap.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares an indexed binary heap (priority queue) of store slots.
+ *
+ * The heap orders slots of a store with a comparison callback and remembers where each slot is,
+ * so a slot can be removed or repositioned after its key changes in O(log n).
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+/**
+ * @brief Ordering callback: returns nonzero if slot a must leave the heap before slot b.
+ */
+typedef int (*HeapBefore)(const void* context, int a, int b);
+
+/**
+ * @brief Indexed binary heap of slots.
+ */
+typedef struct {
+    int* items;         /**< Slots in heap order (items[0] is the first to leave). */
+    int count;
+    int capacity;
+    int* position;      /**< Position of each slot in items, or -1 if the slot is not in the heap. */
+    int positionCapacity;
+    HeapBefore before;
+    const void* context; /**< Passed to the callback (usually the store owning the slots). */
+} Heap;
+
+/**
+ * @brief Initializes an empty heap.
+ *
+ * @param heap Pointer to the heap.
+ * @param before Ordering callback.
+ * @param context Pointer passed to the callback.
+ */
+void heapInit(Heap* heap, HeapBefore before, const void* context);
+
+/**
+ * @brief Adds a slot, or repositions it if it is already in the heap.
+ *
+ * @param heap Pointer to the heap.
+ * @param slot Slot to add.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int heapPush(Heap* heap, int slot);
+
+/**
+ * @brief Returns the first slot without removing it.
+ *
+ * @param heap Pointer to the heap.
+ * @return Returns the slot, or -1 if the heap is empty.
+ */
+int heapPeek(const Heap* heap);
+
+/**
+ * @brief Removes and returns the first slot.
+ *
+ * @param heap Pointer to the heap.
+ * @return Returns the slot, or -1 if the heap is empty.
+ */
+int heapPop(Heap* heap);
+
+/**
+ * @brief Removes a slot from the heap (does nothing if it is not there).
+ *
+ * @param heap Pointer to the heap.
+ * @param slot Slot to remove.
+ */
+void heapRemove(Heap* heap, int slot);
+
+/**
+ * @brief Repositions a slot after its key changed (does nothing if it is not in the heap).
+ *
+ * @param heap Pointer to the heap.
+ * @param slot Slot whose key changed.
+ */
+void heapUpdate(Heap* heap, int slot);
+
+/**
+ * @brief Tells whether a slot is in the heap.
+ *
+ * @param heap Pointer to the heap.
+ * @param slot Slot to check.
+ * @return Returns 1 if the slot is in the heap, 0 otherwise.
+ */
+int heapContains(const Heap* heap, int slot);
+
+/**
+ * @brief Returns the first k slots in order, without modifying the heap (O(k log k)).
+ *
+ * @param heap Pointer to the heap.
+ * @param k Maximum number of slots to return.
+ * @param out Array with room for k slots.
+ * @return Returns the number of slots written to out.
+ */
+int heapFirst(const Heap* heap, int k, int* out);
+
+/**
+ * @brief Frees all memory used by the heap and leaves it empty.
+ *
+ * @param heap Pointer to the heap.
+ */
+void heapFree(Heap* heap);
+
+#endif // HEAP_H
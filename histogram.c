@@ -0,0 +1,152 @@
+/**
+ * @file histogram.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the streaming log-linear histograms.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+
+#include "histogram.h"
+#include "store.h"
+
+#define SUB_BITS 5
+#define SUB_COUNT (1 << SUB_BITS)    // Buckets per power of two
+#define LINEAR_LIMIT (2 * SUB_COUNT) // Values below this are counted exactly
+
+/**
+ * @brief Returns the bucket of a value.
+ */
+static int bucketOf(int value) {
+    int high = 0, shift;
+    if (value < LINEAR_LIMIT) return value < 0 ? 0 : value;
+    while ((value >> (high + 1)) != 0) high++;
+    // The top SUB_BITS + 1 bits of the value select the bucket.
+    shift = high - SUB_BITS;
+    return LINEAR_LIMIT + (shift - 1) * SUB_COUNT + ((value >> shift) - SUB_COUNT);
+}
+
+/**
+ * @brief Returns the value in the middle of a bucket.
+ */
+static int bucketValue(int bucket) {
+    int shift, lowest;
+    if (bucket < LINEAR_LIMIT) return bucket;
+    shift = (bucket - LINEAR_LIMIT) / SUB_COUNT + 1;
+    lowest = ((bucket - LINEAR_LIMIT) % SUB_COUNT + SUB_COUNT) << shift;
+    return lowest + ((1 << shift) - 1) / 2;
+}
+
+/**
+ * @brief Initializes an empty histogram.
+ */
+void histogramInit(Histogram* histogram) {
+    int i;
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++) histogram->counts[i] = 0;
+    histogram->total = 0;
+    histogram->sum = 0;
+}
+
+/**
+ * @brief Adds a value.
+ */
+void histogramAdd(Histogram* histogram, int value) {
+    if (value < 0) value = 0;
+    histogram->counts[bucketOf(value)]++;
+    histogram->total++;
+    histogram->sum += value;
+}
+
+/**
+ * @brief Removes a value previously added.
+ */
+void histogramRemove(Histogram* histogram, int value) {
+    if (value < 0) value = 0;
+    histogram->counts[bucketOf(value)]--;
+    histogram->total--;
+    histogram->sum -= value;
+}
+
+/**
+ * @brief Adds every value of a histogram to another.
+ */
+void histogramMerge(Histogram* into, const Histogram* from) {
+    int i;
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++) into->counts[i] += from->counts[i];
+    into->total += from->total;
+    into->sum += from->sum;
+}
+
+/**
+ * @brief Returns the value below which a percentage of the values fall.
+ */
+int histogramPercentile(const Histogram* histogram, double percentile) {
+    double wanted = percentile / 100.0 * histogram->total;
+    int rank = (int) wanted;
+    int i, seen = 0;
+
+    if (histogram->total == 0) return 0;
+    if (rank < wanted) rank++; // Round up: the value at position ceil(p * n)
+    if (rank < 1) rank = 1;
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->counts[i];
+        if (seen >= rank) return bucketValue(i);
+    }
+    return bucketValue(HISTOGRAM_BUCKETS - 1);
+}
+
+/**
+ * @brief Returns the mean of the values.
+ */
+double histogramMean(const Histogram* histogram) {
+    return histogram->total ? histogram->sum / histogram->total : 0.0;
+}
+
+/**
+ * @brief Initializes a grid of empty histograms.
+ */
+int histogramGridInit(HistogramGrid* grid, int cellCount) {
+    int i;
+    grid->cells = (Histogram*) malloc(sizeof(Histogram) * cellCount);
+    grid->cellCount = grid->cells ? cellCount : 0;
+    grid->samples = NULL;
+    grid->sampleCapacity = 0;
+    for (i = 0; i < grid->cellCount; i++) histogramInit(&grid->cells[i]);
+    return grid->cells != NULL;
+}
+
+/**
+ * @brief Sets the value a record contributes, replacing its previous contribution.
+ */
+int histogramGridTrack(HistogramGrid* grid, int slot, int cell, int value) {
+    int oldCapacity = grid->sampleCapacity;
+    HistogramSample* sample;
+    int i;
+
+    if (!storeReserve((void**) &grid->samples, &grid->sampleCapacity, NULL, slot + 1, sizeof(HistogramSample))) return 0;
+    for (i = oldCapacity; i < grid->sampleCapacity; i++) grid->samples[i].cell = -1;
+
+    sample = &grid->samples[slot];
+    if (sample->cell == cell && (cell < 0 || sample->value == value)) return 1;
+    if (sample->cell >= 0) histogramRemove(&grid->cells[sample->cell], sample->value);
+    sample->cell = cell < grid->cellCount ? cell : -1;
+    sample->value = value;
+    if (sample->cell >= 0) histogramAdd(&grid->cells[sample->cell], value);
+    return 1;
+}
+
+/**
+ * @brief Frees all memory used by the grid.
+ */
+void histogramGridFree(HistogramGrid* grid) {
+    free(grid->cells);
+    free(grid->samples);
+    grid->cells = NULL;
+    grid->cellCount = 0;
+    grid->samples = NULL;
+    grid->sampleCapacity = 0;
+}
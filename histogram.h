@@ -0,0 +1,130 @@
+/**
+ * @file histogram.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares streaming log-linear histograms for percentile statistics.
+ *
+ * Values (durations in minutes) are counted in buckets whose width grows with the value, in the
+ * manner of HDR histograms: exact below 64, then 32 buckets per power of two (relative error
+ * under 2%). Memory is fixed, values can be added and removed, and percentiles are read in
+ * constant time with respect to the number of values.
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+/**
+ * @brief Number of buckets: 64 exact values, then 25 powers of two of 32 buckets each.
+ */
+#define HISTOGRAM_BUCKETS 864
+
+/**
+ * @brief Histogram of non-negative int values.
+ */
+typedef struct {
+    int counts[HISTOGRAM_BUCKETS];
+    int total;
+    double sum; /**< Sum of the values (a double cannot overflow where an int sum would). */
+} Histogram;
+
+/**
+ * @brief Value contributed by one record to a grid of histograms.
+ */
+typedef struct {
+    int cell; /**< Histogram the value was added to, or -1 if none. */
+    int value;
+} HistogramSample;
+
+/**
+ * @brief Set of histograms (e.g. one per type and priority) fed by the records of a store.
+ *
+ * The grid remembers what each record (by slot) contributed, so a record can be re-tracked
+ * after any change and its previous value is removed first.
+ */
+typedef struct {
+    Histogram* cells;
+    int cellCount;
+    HistogramSample* samples;
+    int sampleCapacity;
+} HistogramGrid;
+
+/**
+ * @brief Initializes an empty histogram.
+ *
+ * @param histogram Pointer to the histogram.
+ */
+void histogramInit(Histogram* histogram);
+
+/**
+ * @brief Adds a value (negative values count as 0).
+ *
+ * @param histogram Pointer to the histogram.
+ * @param value Value to add.
+ */
+void histogramAdd(Histogram* histogram, int value);
+
+/**
+ * @brief Removes a value previously added.
+ *
+ * @param histogram Pointer to the histogram.
+ * @param value Value to remove.
+ */
+void histogramRemove(Histogram* histogram, int value);
+
+/**
+ * @brief Adds every value of a histogram to another.
+ *
+ * @param into Pointer to the histogram that receives the values.
+ * @param from Pointer to the histogram whose values are added.
+ */
+void histogramMerge(Histogram* into, const Histogram* from);
+
+/**
+ * @brief Returns the value below which a percentage of the values fall.
+ *
+ * @param histogram Pointer to the histogram.
+ * @param percentile Percentage, from 0 to 100 (e.g. 95 for p95).
+ * @return Returns the value (within the bucket precision), or 0 if the histogram is empty.
+ */
+int histogramPercentile(const Histogram* histogram, double percentile);
+
+/**
+ * @brief Returns the mean of the values.
+ *
+ * @param histogram Pointer to the histogram.
+ * @return Returns the mean, or 0 if the histogram is empty.
+ */
+double histogramMean(const Histogram* histogram);
+
+/**
+ * @brief Initializes a grid of empty histograms.
+ *
+ * @param grid Pointer to the grid.
+ * @param cellCount Number of histograms.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int histogramGridInit(HistogramGrid* grid, int cellCount);
+
+/**
+ * @brief Sets the value a record contributes, replacing its previous contribution.
+ *
+ * @param grid Pointer to the grid.
+ * @param slot Slot of the record in its store.
+ * @param cell Histogram the value goes to, or -1 if the record contributes nothing.
+ * @param value Value contributed.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int histogramGridTrack(HistogramGrid* grid, int slot, int cell, int value);
+
+/**
+ * @brief Frees all memory used by the grid.
+ *
+ * @param grid Pointer to the grid.
+ */
+void histogramGridFree(HistogramGrid* grid);
+
+#endif // HISTOGRAM_H
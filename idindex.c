@@ -0,0 +1,110 @@
+/**
+ * @file idindex.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.1
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the ID hash index shared by all entity modules.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+
+#include "idindex.h"
+
+#define INITIAL_BUCKETS 64
+#define ENTRIES_PER_CHUNK 1024
+
+/**
+ * @brief Spreads sequential IDs across the buckets (Knuth multiplicative hash).
+ */
+static unsigned int hashId(int id, int bucketCount) {
+    return ((unsigned int) id * 2654435761u) & (unsigned int) (bucketCount - 1);
+}
+
+/**
+ * @brief Doubles the number of buckets and redistributes the entries.
+ */
+static int growIndex(IdIndex* index) {
+    int newCount = index->bucketCount ? index->bucketCount * 2 : INITIAL_BUCKETS;
+    IdIndexEntry** newBuckets = (IdIndexEntry**) calloc(newCount, sizeof(IdIndexEntry*));
+    int i;
+    if (!newBuckets) return 0;
+
+    for (i = 0; i < index->bucketCount; i++) {
+        IdIndexEntry* entry = index->buckets[i];
+        while (entry) {
+            IdIndexEntry* next = entry->next;
+            unsigned int b = hashId(entry->id, newCount);
+            entry->next = newBuckets[b];
+            newBuckets[b] = entry;
+            entry = next;
+        }
+    }
+    free(index->buckets);
+    index->buckets = newBuckets;
+    index->bucketCount = newCount;
+    return 1;
+}
+
+/**
+ * @brief Initializes an empty index.
+ */
+void idIndexInit(IdIndex* index) {
+    index->buckets = NULL;
+    index->bucketCount = 0;
+    index->size = 0;
+    poolInit(&index->entries, sizeof(IdIndexEntry), ENTRIES_PER_CHUNK);
+}
+
+/**
+ * @brief Inserts or replaces the slot associated with an ID.
+ */
+int idIndexPut(IdIndex* index, int id, int slot) {
+    IdIndexEntry* entry;
+    unsigned int b;
+
+    // Keep the load factor below 0.75 so chains stay short.
+    if (index->bucketCount == 0 || index->size * 4 >= index->bucketCount * 3) {
+        if (!growIndex(index)) return 0;
+    }
+
+    b = hashId(id, index->bucketCount);
+    for (entry = index->buckets[b]; entry; entry = entry->next) {
+        if (entry->id == id) {
+            entry->slot = slot;
+            return 1;
+        }
+    }
+
+    entry = (IdIndexEntry*) poolAlloc(&index->entries);
+    if (!entry) return 0;
+    entry->id = id;
+    entry->slot = slot;
+    entry->next = index->buckets[b];
+    index->buckets[b] = entry;
+    index->size++;
+    return 1;
+}
+
+/**
+ * @brief Finds the slot associated with an ID.
+ */
+int idIndexGet(const IdIndex* index, int id) {
+    IdIndexEntry* entry;
+    if (index->bucketCount == 0) return -1;
+    for (entry = index->buckets[hashId(id, index->bucketCount)]; entry; entry = entry->next) {
+        if (entry->id == id) return entry->slot;
+    }
+    return -1;
+}
+
+/**
+ * @brief Releases all memory used by the index (whole chunks at once).
+ */
+void idIndexFree(IdIndex* index) {
+    poolRelease(&index->entries);
+    free(index->buckets);
+    idIndexInit(index);
+}
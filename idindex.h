@@ -0,0 +1,69 @@
+/**
+ * @file idindex.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.1
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares a hash index that maps entity IDs to their position in a store in constant time.
+ */
+
+#ifndef IDINDEX_H
+#define IDINDEX_H
+
+#include "pool.h"
+
+/**
+ * @brief Entry of the ID index (separate chaining).
+ */
+typedef struct IdIndexEntry {
+    int id;
+    int slot;
+    struct IdIndexEntry* next;
+} IdIndexEntry;
+
+/**
+ * @brief Hash table keyed by entity ID.
+ */
+typedef struct {
+    IdIndexEntry** buckets;
+    int bucketCount;
+    int size;
+    Pool entries; /**< Entries are allocated in chunks instead of one malloc per ID. */
+} IdIndex;
+
+/**
+ * @brief Initializes an empty index.
+ *
+ * @param index Pointer to the index to initialize.
+ */
+void idIndexInit(IdIndex* index);
+
+/**
+ * @brief Inserts or replaces the slot associated with an ID.
+ *
+ * @param index Pointer to the index.
+ * @param id Entity ID used as key.
+ * @param slot Position of the record in its store.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int idIndexPut(IdIndex* index, int id, int slot);
+
+/**
+ * @brief Finds the slot associated with an ID.
+ *
+ * @param index Pointer to the index.
+ * @param id Entity ID to search for.
+ * @return Returns the slot, or -1 if the ID is not indexed.
+ */
+int idIndexGet(const IdIndex* index, int id);
+
+/**
+ * @brief Releases all memory used by the index and leaves it empty.
+ *
+ * @param index Pointer to the index.
+ */
+void idIndexFree(IdIndex* index);
+
+#endif // IDINDEX_H
@@ -0,0 +1,704 @@
+/**
+ * @file import.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the bulk importer of historical occurrences and interventions.
+ */
+
+#include <stdio.h>   // Provides standard input and output functions (e.g., fopen, fprintf)
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for memory manipulation (e.g., memchr, memcpy)
+#include <ctype.h>   // Provides tolower
+
+#if defined(__unix__) || defined(__APPLE__)
+#define IMPORT_USE_MMAP
+#include <fcntl.h>     // Provides open
+#include <sys/mman.h>  // Provides mmap, munmap
+#include <sys/stat.h>  // Provides fstat
+#include <unistd.h>    // Provides close
+#endif
+
+#include "import.h"
+#include "parallel.h"
+#include "store.h"
+#include "symbols.h"
+#include "datetime.h"
+#include "occurrences.h"
+#include "interventions.h"
+
+#define IMPORT_BLOCK 65536    // Bytes per unit handed to the worker pool
+#define IMPORT_MIN_BLOCKS 16  // At least 1 MiB of input per partition
+#define ROW_FIELDS 6
+
+/**
+ * @brief How the characters of a text field are escaped in the input.
+ */
+enum { TEXT_PLAIN, TEXT_CSV, TEXT_JSON };
+
+/**
+ * @brief A field of a row: points into the input, nothing is copied.
+ */
+typedef struct {
+    const char* start; /**< NULL if the field is missing. */
+    int length;
+    int encoding;
+} Field;
+
+/**
+ * @brief A parsed occurrence row; its location stays in the input until the rows are stored.
+ */
+typedef struct {
+    Occurrence record; /**< Every field but the ID and the location. */
+    Field location;
+} OccurrenceRow;
+
+/**
+ * @brief Rows parsed by one partition (OccurrenceRow or Intervention) and its rejected lines.
+ */
+typedef struct {
+    void* rows;
+    int count;
+    int capacity;
+    int lines; /**< Lines of the partition, to number the lines of the next ones. */
+    int rejected;
+    int rejectedLines[IMPORT_REPORTED_ERRORS]; /**< Counted from the start of the partition. */
+    int failed; /**< Memory ran out. */
+} ImportPart;
+
+/**
+ * @brief Input and partial results shared by the partitions of an import.
+ */
+typedef struct {
+    const char* data;
+    size_t size;
+    size_t skipped; /**< Bytes of the file before data (byte order mark). */
+    int json;
+    int interventions; /**< Rows are interventions (otherwise occurrences). */
+    const OccurrenceStore* occurrences;
+    const FirefighterStore* firefighters;
+    const EquipmentStore* equipments;
+    ImportPart parts[PARALLEL_MAX_WORKERS];
+} ImportJob;
+
+static const char* const OCCURRENCE_KEYS[ROW_FIELDS] = {"location", "type", "priority", "status", "timestamp", "endedAt"};
+static const char* const INTERVENTION_KEYS[ROW_FIELDS] = {"occurrence", "start", "end", "status", "crew", "equipment"};
+
+static int fieldEmpty(const Field* field) {
+    return field->start == NULL || field->length == 0;
+}
+
+/**
+ * @brief Splits a CSV line into fields (missing trailing fields are left empty).
+ */
+static int splitCsv(const char* cursor, const char* end, Field* fields) {
+    int count = 0;
+
+    memset(fields, 0, sizeof(Field) * ROW_FIELDS);
+    for (;;) {
+        Field* field = &fields[count];
+        while (cursor < end && *cursor == ' ') cursor++;
+        if (cursor < end && *cursor == '"') {
+            field->start = ++cursor;
+            while (cursor < end && (*cursor != '"' || (cursor + 1 < end && cursor[1] == '"'))) {
+                cursor += *cursor == '"' ? 2 : 1;
+            }
+            if (cursor == end) return 0; // Unterminated quotes
+            field->length = (int) (cursor - field->start);
+            field->encoding = TEXT_CSV;
+            cursor++;
+            while (cursor < end && *cursor == ' ') cursor++;
+            if (cursor < end && *cursor != ',') return 0;
+        } else {
+            field->start = cursor;
+            while (cursor < end && *cursor != ',') cursor++;
+            field->length = (int) (cursor - field->start);
+            while (field->length > 0 && field->start[field->length - 1] == ' ') field->length--;
+            field->encoding = TEXT_PLAIN;
+        }
+        count++;
+        if (cursor == end) return 1;
+        if (count == ROW_FIELDS) return 0;
+        cursor++; // Skip the comma
+    }
+}
+
+static const char* skipSpaces(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) cursor++;
+    return cursor;
+}
+
+/**
+ * @brief Finds the closing quote of a JSON string (cursor is just after the opening one).
+ */
+static const char* jsonStringEnd(const char* cursor, const char* end) {
+    while (cursor < end && *cursor != '"') cursor += *cursor == '\\' ? 2 : 1;
+    return cursor < end ? cursor : NULL;
+}
+
+/**
+ * @brief Splits a flat JSON object into the fields named by keys (unknown keys are ignored).
+ */
+static int splitJson(const char* cursor, const char* end, const char* const* keys, Field* fields) {
+    memset(fields, 0, sizeof(Field) * ROW_FIELDS);
+    cursor = skipSpaces(cursor, end);
+    if (cursor == end || *cursor++ != '{') return 0;
+
+    for (;;) {
+        const char* key;
+        const char* keyEnd;
+        Field value;
+        int i;
+
+        cursor = skipSpaces(cursor, end);
+        if (cursor < end && *cursor == '}') break;
+        if (cursor == end || *cursor != '"') return 0;
+        key = cursor + 1;
+        keyEnd = jsonStringEnd(key, end);
+        if (!keyEnd) return 0;
+        cursor = skipSpaces(keyEnd + 1, end);
+        if (cursor == end || *cursor++ != ':') return 0;
+        cursor = skipSpaces(cursor, end);
+        if (cursor == end) return 0;
+
+        if (*cursor == '"') {
+            const char* stringEnd = jsonStringEnd(cursor + 1, end);
+            if (!stringEnd) return 0;
+            value.start = cursor + 1;
+            value.length = (int) (stringEnd - value.start);
+            value.encoding = TEXT_JSON;
+            cursor = stringEnd + 1;
+        } else if (*cursor == '[') {
+            const char* close = (const char*) memchr(cursor, ']', (size_t) (end - cursor));
+            if (!close) return 0;
+            value.start = cursor + 1;
+            value.length = (int) (close - value.start);
+            value.encoding = TEXT_PLAIN;
+            cursor = close + 1;
+        } else {
+            value.start = cursor;
+            while (cursor < end && *cursor != ',' && *cursor != '}' && *cursor != ' ' && *cursor != '\t') cursor++;
+            value.length = (int) (cursor - value.start);
+            value.encoding = TEXT_PLAIN;
+            if (value.length == 4 && memcmp(value.start, "null", 4) == 0) value.start = NULL;
+        }
+
+        for (i = 0; i < ROW_FIELDS; i++) {
+            if ((size_t) (keyEnd - key) == strlen(keys[i]) && memcmp(key, keys[i], (size_t) (keyEnd - key)) == 0) {
+                fields[i] = value;
+            }
+        }
+
+        cursor = skipSpaces(cursor, end);
+        if (cursor < end && *cursor == ',') {
+            cursor++;
+            continue;
+        }
+        if (cursor == end || *cursor != '}') return 0;
+        break;
+    }
+    return skipSpaces(cursor + 1, end) == end;
+}
+
+/**
+ * @brief Appends a code point to a text as UTF-8; returns the new length, or -1 if it does not fit.
+ */
+static int putCodePoint(char* text, int length, unsigned long code) {
+    if (code < 0x80) {
+        if (length + 1 >= MAX_STRING) return -1;
+        text[length++] = (char) code;
+    } else if (code < 0x800) {
+        if (length + 2 >= MAX_STRING) return -1;
+        text[length++] = (char) (0xC0 | (code >> 6));
+        text[length++] = (char) (0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        if (length + 3 >= MAX_STRING) return -1;
+        text[length++] = (char) (0xE0 | (code >> 12));
+        text[length++] = (char) (0x80 | ((code >> 6) & 0x3F));
+        text[length++] = (char) (0x80 | (code & 0x3F));
+    } else {
+        if (length + 4 >= MAX_STRING) return -1;
+        text[length++] = (char) (0xF0 | (code >> 18));
+        text[length++] = (char) (0x80 | ((code >> 12) & 0x3F));
+        text[length++] = (char) (0x80 | ((code >> 6) & 0x3F));
+        text[length++] = (char) (0x80 | (code & 0x3F));
+    }
+    return length;
+}
+
+/**
+ * @brief Reads the four hex digits of a JSON \\u escape.
+ */
+static int hexQuad(const char* cursor, const char* end, unsigned long* code) {
+    int i;
+    *code = 0;
+    if (end - cursor < 4) return 0;
+    for (i = 0; i < 4; i++) {
+        char c = cursor[i];
+        int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (digit < 0) return 0;
+        *code = *code * 16 + (unsigned long) digit;
+    }
+    return 1;
+}
+
+/**
+ * @brief Copies a text field into a buffer of MAX_STRING characters, undoing its escapes.
+ *
+ * @return Returns the length of the text, or -1 if it is missing, too long or badly escaped.
+ */
+static int decodeText(const Field* field, char* text) {
+    const char* cursor = field->start;
+    const char* end = cursor + field->length;
+    int length = 0;
+
+    if (fieldEmpty(field)) return -1;
+    while (cursor < end) {
+        unsigned long code = (unsigned char) *cursor++;
+        if (field->encoding == TEXT_CSV && code == '"') {
+            cursor++; // "" stands for one quote
+        } else if (field->encoding == TEXT_JSON && code == '\\') {
+            char escape = cursor < end ? *cursor++ : '\0';
+            switch (escape) {
+                case '"': case '\\': case '/': code = (unsigned long) escape; break;
+                case 'b': code = '\b'; break;
+                case 'f': code = '\f'; break;
+                case 'n': code = '\n'; break;
+                case 'r': code = '\r'; break;
+                case 't': code = '\t'; break;
+                case 'u':
+                    if (!hexQuad(cursor, end, &code)) return -1;
+                    cursor += 4;
+                    if (code >= 0xD800 && code < 0xDC00) {
+                        unsigned long low;
+                        // A surrogate pair: the second half must follow as another escape.
+                        if (end - cursor < 6 || cursor[0] != '\\' || cursor[1] != 'u' || !hexQuad(cursor + 2, end, &low)) return -1;
+                        if (low < 0xDC00 || low > 0xDFFF) return -1;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        cursor += 6;
+                    }
+                    length = putCodePoint(text, length, code);
+                    if (length < 0) return -1;
+                    continue;
+                default:
+                    return -1;
+            }
+        }
+        if (length + 1 >= MAX_STRING) return -1;
+        text[length++] = (char) code;
+    }
+    text[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Reads a whole number within [min, max].
+ */
+static int fieldInt(const Field* field, int min, int max, int* value) {
+    const char* cursor = field->start;
+    const char* end;
+    long number = 0;
+
+    if (fieldEmpty(field)) return 0;
+    end = cursor + field->length;
+    for (; cursor < end; cursor++) {
+        if (*cursor < '0' || *cursor > '9') return 0;
+        number = number * 10 + (*cursor - '0');
+        if (number > max) return 0;
+    }
+    if (number < min) return 0;
+    *value = (int) number;
+    return 1;
+}
+
+/**
+ * @brief Reads a "dd/mm/yyyy hh:mm" date.
+ */
+static int fieldTimestamp(const Field* field, Timestamp* t) {
+    char text[32];
+    if (fieldEmpty(field) || field->length >= (int) sizeof(text)) return 0;
+    memcpy(text, field->start, (size_t) field->length);
+    text[field->length] = '\0';
+    return parseTimestamp(text, t);
+}
+
+/**
+ * @brief Reads a list of IDs separated by spaces or commas; returns how many, or -1 if invalid.
+ */
+static int fieldIds(const Field* field, int* ids, int max) {
+    const char* cursor = field->start;
+    const char* end = cursor + field->length;
+    int count = 0;
+
+    if (fieldEmpty(field)) return 0;
+    for (;;) {
+        Field number;
+        while (cursor < end && (*cursor == ' ' || *cursor == ',')) cursor++;
+        if (cursor == end) return count;
+        number.start = cursor;
+        while (cursor < end && *cursor != ' ' && *cursor != ',') cursor++;
+        number.length = (int) (cursor - number.start);
+        if (count == max || !fieldInt(&number, 1, MAX_ID, &ids[count])) return -1;
+        count++;
+    }
+}
+
+/**
+ * @brief Checks that the IDs of a list are distinct and all present in an index.
+ */
+static int knownDistinctIds(const IdIndex* index, const int* ids, int count) {
+    int i, j;
+    for (i = 0; i < count; i++) {
+        if (idIndexGet(index, ids[i]) < 0) return 0;
+        for (j = 0; j < i; j++) {
+            if (ids[j] == ids[i]) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Validates an occurrence row; the location is only checked, it is interned later.
+ */
+static int parseOccurrenceRow(const Field* fields, OccurrenceRow* row) {
+    char location[MAX_STRING];
+    int type, priority, status;
+
+    if (decodeText(&fields[0], location) <= 0) return 0;
+    if (!fieldInt(&fields[1], 0, 2, &type) || !fieldInt(&fields[2], 0, 2, &priority)) return 0;
+    if (!fieldInt(&fields[3], 0, 3, &status) || !fieldTimestamp(&fields[4], &row->record.timestamp)) return 0;
+    row->record.endedAt = NO_TIMESTAMP;
+    if (!fieldEmpty(&fields[5])) {
+        if (!fieldTimestamp(&fields[5], &row->record.endedAt) || row->record.endedAt < row->record.timestamp) return 0;
+    }
+
+    row->record.id = 0;
+    row->record.location = -1;
+    row->record.type = (OccurrenceType) type;
+    row->record.priority = (Priority) priority;
+    row->record.status = (OccurrenceStatus) status;
+    row->location = fields[0];
+    return 1;
+}
+
+/**
+ * @brief Validates a closed intervention row against the stores (read-only, so safe in parallel).
+ */
+static int parseInterventionRow(const ImportJob* job, const Field* fields, Intervention* record) {
+    int status;
+
+    memset(record, 0, sizeof(Intervention));
+    if (!fieldInt(&fields[0], 1, MAX_ID, &record->idOccurrence)) return 0;
+    if (idIndexGet(&job->occurrences->index, record->idOccurrence) < 0) return 0;
+    if (!fieldTimestamp(&fields[1], &record->start)) return 0;
+    record->end = NO_TIMESTAMP;
+    if (!fieldEmpty(&fields[2])) {
+        if (!fieldTimestamp(&fields[2], &record->end) || record->end < record->start) return 0;
+    }
+    if (!fieldInt(&fields[3], FINISHED, INTERVENTION_INACTIVE, &status)) return 0;
+    if (status == FINISHED && record->end == NO_TIMESTAMP) return 0;
+    record->status = (InterventionStatus) status;
+
+    record->crewCount = fieldIds(&fields[4], record->crew, MAX_CREW);
+    record->equipmentCount = fieldIds(&fields[5], record->equipment, MAX_INTERVENTION_EQUIPMENT);
+    if (record->crewCount < 1 || record->equipmentCount < 0) return 0;
+    return knownDistinctIds(&job->firefighters->index, record->crew, record->crewCount)
+           && knownDistinctIds(&job->equipments->index, record->equipment, record->equipmentCount);
+}
+
+/**
+ * @brief Tells whether the first CSV line is a header: its first field is the name of the first
+ * column ("location" or "occurrence", in any case). Other lines that fail to parse are rejected.
+ */
+static int isHeader(const ImportJob* job, const char* line, const char* end) {
+    const char* name = job->interventions ? INTERVENTION_KEYS[0] : OCCURRENCE_KEYS[0];
+    Field fields[ROW_FIELDS];
+    int i;
+
+    if (!splitCsv(line, end, fields) || fieldEmpty(&fields[0]) || fields[0].length != (int) strlen(name)) return 0;
+    for (i = 0; i < fields[0].length; i++) {
+        if (tolower((unsigned char) fields[0].start[i]) != name[i]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Parses the lines that start inside blocks [from, to) of the input.
+ */
+static void parsePart(void* context, int part, int from, int to) {
+    ImportJob* job = (ImportJob*) context;
+    ImportPart* out = &job->parts[part];
+    const char* inputEnd = job->data + job->size;
+    size_t rowSize = job->interventions ? sizeof(Intervention) : sizeof(OccurrenceRow);
+    size_t begin = (size_t) from * IMPORT_BLOCK;
+    size_t end = (size_t) to * IMPORT_BLOCK;
+    const char* cursor;
+
+    memset(out, 0, sizeof(ImportPart));
+    if (end > job->size) end = job->size;
+    if (begin >= end) return;
+    // A line belongs to the partition it starts in: skip the one the previous partition owns.
+    if (begin > 0) {
+        const char* newline = (const char*) memchr(job->data + begin - 1, '\n', job->size - begin + 1);
+        if (!newline) return;
+        begin = (size_t) (newline + 1 - job->data);
+    }
+
+    cursor = job->data + begin;
+    while (cursor < job->data + end) {
+        const char* lineEnd = (const char*) memchr(cursor, '\n', (size_t) (inputEnd - cursor));
+        const char* next;
+        const char* first;
+        Field fields[ROW_FIELDS];
+        int ok;
+
+        if (!lineEnd) lineEnd = inputEnd;
+        next = lineEnd < inputEnd ? lineEnd + 1 : lineEnd;
+        out->lines++;
+        if (lineEnd > cursor && lineEnd[-1] == '\r') lineEnd--;
+        first = skipSpaces(cursor, lineEnd);
+        if (first == lineEnd) {
+            cursor = next;
+            continue;
+        }
+
+        if (!storeReserve(&out->rows, &out->capacity, NULL, out->count + 1, rowSize)) {
+            out->failed = 1;
+            return;
+        }
+        if (job->json) ok = splitJson(first, lineEnd, job->interventions ? INTERVENTION_KEYS : OCCURRENCE_KEYS, fields);
+        else ok = splitCsv(first, lineEnd, fields);
+        if (ok && job->interventions) ok = parseInterventionRow(job, fields, (Intervention*) out->rows + out->count);
+        else if (ok) ok = parseOccurrenceRow(fields, (OccurrenceRow*) out->rows + out->count);
+
+        if (ok) {
+            out->count++;
+        } else if (!(begin == 0 && out->lines == 1 && !job->json && isHeader(job, first, lineEnd))) {
+            if (out->rejected < IMPORT_REPORTED_ERRORS) out->rejectedLines[out->rejected] = out->lines;
+            out->rejected++;
+        }
+        cursor = next;
+    }
+}
+
+/**
+ * @brief Maps (or reads) a whole input file.
+ */
+static int openInput(const char* path, const char** data, size_t* size) {
+#ifdef IMPORT_USE_MMAP
+    struct stat info;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return 0;
+    }
+    *size = (size_t) info.st_size;
+    *data = NULL;
+    if (*size > 0) {
+        void* mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            return 0;
+        }
+        madvise(mapping, *size, MADV_SEQUENTIAL);
+        *data = (const char*) mapping;
+    }
+    close(fd);
+    return 1;
+#else
+    FILE* fp = fopen(path, "rb");
+    long length;
+    char* buffer;
+    if (!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    buffer = (char*) malloc(length > 0 ? (size_t) length : 1);
+    if (!buffer || fread(buffer, 1, (size_t) length, fp) != (size_t) length) {
+        free(buffer);
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+    *data = buffer;
+    *size = (size_t) length;
+    return 1;
+#endif
+}
+
+static void closeInput(const char* data, size_t size) {
+#ifdef IMPORT_USE_MMAP
+    if (data) munmap((void*) data, size);
+#else
+    free((void*) data);
+#endif
+}
+
+/**
+ * @brief Opens the input and parses it on the worker pool; returns the number of partitions used.
+ */
+static int parseInput(const char* path, ImportJob* job, ImportResult* result) {
+    const char* cursor;
+    int parts, part, lineBase = 0, reported = 0;
+
+    if (!openInput(path, &job->data, &job->size)) return -1;
+
+    // A UTF-8 byte order mark is not part of the first line.
+    if (job->size >= 3 && memcmp(job->data, "\xEF\xBB\xBF", 3) == 0) {
+        job->data += 3;
+        job->size -= 3;
+        job->skipped = 3;
+    }
+    cursor = job->data;
+    while (cursor < job->data + job->size && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n')) cursor++;
+    job->json = cursor < job->data + job->size && *cursor == '{';
+
+    parts = parallelFor((int) ((job->size + IMPORT_BLOCK - 1) / IMPORT_BLOCK), IMPORT_MIN_BLOCKS, parsePart, job);
+
+    // Number the rejected lines of each partition after the lines of the previous ones.
+    for (part = 0; part < parts; part++) {
+        const ImportPart* current = &job->parts[part];
+        int i;
+        for (i = 0; i < current->rejected && i < IMPORT_REPORTED_ERRORS && reported < IMPORT_REPORTED_ERRORS; i++) {
+            result->rejectedLines[reported++] = lineBase + current->rejectedLines[i];
+        }
+        result->rejected += current->rejected;
+        lineBase += current->lines;
+    }
+    return parts;
+}
+
+/**
+ * @brief Releases the partial results and the input of an import.
+ */
+static void finishInput(ImportJob* job, int parts) {
+    int part;
+    for (part = 0; part < parts; part++) free(job->parts[part].rows);
+    closeInput(job->data - job->skipped, job->size + job->skipped);
+}
+
+/**
+ * @brief Imports historical occurrences from a CSV or NDJSON file.
+ */
+int importOccurrences(const char* path, OccurrenceStore* store, int* idSeq, ImportResult* result) {
+    ImportJob* job = (ImportJob*) calloc(1, sizeof(ImportJob));
+    int parts, part, ok = 1;
+
+    memset(result, 0, sizeof(ImportResult));
+    if (!job) return 0;
+    parts = parseInput(path, job, result);
+    if (parts < 0) {
+        free(job);
+        return 0;
+    }
+
+    // One sequential pass in file order: consecutive IDs, locations interned, records appended.
+    for (part = 0; part < parts && ok; part++) {
+        const ImportPart* current = &job->parts[part];
+        const OccurrenceRow* rows = (const OccurrenceRow*) current->rows;
+        Occurrence* records = (Occurrence*) malloc(sizeof(Occurrence) * (current->count > 0 ? current->count : 1));
+        int i, count = current->count;
+
+        if (current->failed || !records) {
+            free(records);
+            ok = 0;
+            break;
+        }
+        // IDs stop at MAX_ID (the highest the menus and batch commands can address).
+        if (count > MAX_ID - *idSeq) count = MAX_ID - *idSeq;
+        result->rejected += current->count - count;
+        for (i = 0; i < count && ok; i++) {
+            char location[MAX_STRING];
+            records[i] = rows[i].record;
+            records[i].id = *idSeq + 1 + i;
+            decodeText(&rows[i].location, location);
+            records[i].location = internString(location);
+            if (records[i].location < 0) ok = 0;
+        }
+        if (ok && count > 0) ok = appendOccurrences(store, records, count);
+        if (ok) {
+            if (result->imported == 0 && count > 0) result->firstId = *idSeq + 1;
+            *idSeq += count;
+            result->imported += count;
+        }
+        free(records);
+    }
+
+    finishInput(job, parts);
+    free(job);
+    return ok;
+}
+
+/**
+ * @brief Imports historical interventions from a CSV or NDJSON file.
+ */
+int importInterventions(const char* path, InterventionStore* store, const OccurrenceStore* occurrences,
+                        const FirefighterStore* firefighters, const EquipmentStore* equipments, int* idSeq,
+                        ImportResult* result) {
+    ImportJob* job = (ImportJob*) calloc(1, sizeof(ImportJob));
+    int parts, part, ok = 1;
+
+    memset(result, 0, sizeof(ImportResult));
+    if (!job) return 0;
+    job->interventions = 1;
+    job->occurrences = occurrences;
+    job->firefighters = firefighters;
+    job->equipments = equipments;
+    parts = parseInput(path, job, result);
+    if (parts < 0) {
+        free(job);
+        return 0;
+    }
+
+    for (part = 0; part < parts && ok; part++) {
+        const ImportPart* current = &job->parts[part];
+        Intervention* rows = (Intervention*) current->rows;
+        int i;
+
+        if (current->failed) {
+            ok = 0;
+            break;
+        }
+        for (i = 0; i < current->count; i++) {
+            if (*idSeq == MAX_ID) {
+                result->rejected += current->count - i;
+                break;
+            }
+            rows[i].id = *idSeq + 1;
+            if (!insertIntervention(store, &rows[i])) {
+                ok = 0;
+                break;
+            }
+            if (result->imported == 0) result->firstId = rows[i].id;
+            (*idSeq)++;
+            result->imported++;
+        }
+    }
+
+    finishInput(job, parts);
+    free(job);
+    return ok;
+}
+
+/**
+ * @brief Prints the outcome of an import on the standard error.
+ */
+void printImportResult(const ImportResult* result) {
+    int i;
+    for (i = 0; i < result->rejected && i < IMPORT_REPORTED_ERRORS; i++) {
+        fprintf(stderr, "Linha %d: registo inválido ou recusado.\n", result->rejectedLines[i]);
+    }
+    if (result->rejected > IMPORT_REPORTED_ERRORS) {
+        fprintf(stderr, "(mais %d linha(s) rejeitada(s))\n", result->rejected - IMPORT_REPORTED_ERRORS);
+    }
+    if (result->imported > 0) {
+        fprintf(stderr, "%d registo(s) importado(s) (IDs %d a %d), %d rejeitado(s).\n", result->imported,
+                result->firstId, result->firstId + result->imported - 1, result->rejected);
+    } else {
+        fprintf(stderr, "0 registo(s) importado(s), %d rejeitado(s).\n", result->rejected);
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file import.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the bulk importer of historical occurrences and interventions (CSV or NDJSON).
+ *
+ * A file whose first non-blank character is '{' is read as NDJSON (one flat JSON object per
+ * line), anything else as CSV (comma-separated, fields may be quoted with "", optionally a header
+ * line whose first field names the first column below; any other unparseable first line is
+ * counted as rejected). Dates are "dd/mm/yyyy hh:mm"; statuses, types and priorities are the
+ * numbers used by the menus. Occurrence rows carry, in this order (or under these keys):
+ *
+ *     location,type,priority,status,timestamp,endedAt
+ *
+ * and intervention rows (crew and equipment are IDs separated by spaces, or JSON arrays):
+ *
+ *     occurrence,start,end,status,crew,equipment
+ *
+ * The file is split into chunks parsed by the worker pool (parallel.h); the rows are then given
+ * consecutive IDs after the current counter (up to MAX_ID), in file order, and appended to the
+ * store in one pass. They are not journaled: the caller must checkpoint (journalCheckpoint) and treat
+ * a failed checkpoint as a failed import, since that is the only write of the rows to the data file.
+ */
+
+#ifndef IMPORT_H
+#define IMPORT_H
+
+#include "data.h"
+
+/**
+ * @brief Number of rejected lines reported individually (the others are only counted).
+ */
+#define IMPORT_REPORTED_ERRORS 10
+
+/**
+ * @brief Outcome of an import.
+ */
+typedef struct {
+    int imported; /**< Records added to the store. */
+    int firstId; /**< ID given to the first record added (0 if none). */
+    int rejected; /**< Lines that could not be parsed or were refused. */
+    int rejectedLines[IMPORT_REPORTED_ERRORS]; /**< Numbers (from 1) of the first rejected lines. */
+} ImportResult;
+
+/**
+ * @brief Imports historical occurrences from a CSV or NDJSON file.
+ *
+ * A row is refused if a field is missing or out of range, or if its end date precedes its start.
+ *
+ * @param path Path of the file.
+ * @param store Pointer to the occurrence store.
+ * @param idSeq Pointer to the occurrence ID counter.
+ * @param result Pointer to receive the outcome (also filled when the import stops early).
+ * @return Returns 1 if the file was read, 0 if it could not be opened or memory ran out. In the latter
+ *         case the rows of the partitions before the failure remain in the store and are counted in result.
+ */
+int importOccurrences(const char* path, OccurrenceStore* store, int* idSeq, ImportResult* result);
+
+/**
+ * @brief Imports historical interventions from a CSV or NDJSON file.
+ *
+ * Only closed interventions are accepted (FINISHED with an end date, or INTERVENTION_INACTIVE):
+ * the current status of the crew and equipment is left untouched. A row is refused if its
+ * occurrence, a crew member or an equipment item does not exist.
+ *
+ * @param path Path of the file.
+ * @param store Pointer to the intervention store.
+ * @param occurrences Pointer to the occurrence store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param idSeq Pointer to the intervention ID counter.
+ * @param result Pointer to receive the outcome (also filled when the import stops early).
+ * @return Returns 1 if the file was read, 0 if it could not be opened or memory ran out. In the latter
+ *         case the rows of the partitions before the failure remain in the store and are counted in result.
+ */
+int importInterventions(const char* path, InterventionStore* store, const OccurrenceStore* occurrences,
+                        const FirefighterStore* firefighters, const EquipmentStore* equipments, int* idSeq,
+                        ImportResult* result);
+
+/**
+ * @brief Prints the outcome of an import (rejected lines and IDs given) on the standard error.
+ *
+ * @param result Outcome returned by importOccurrences or importInterventions.
+ */
+void printImportResult(const ImportResult* result);
+
+#endif // IMPORT_H
@@ -0,0 +1,325 @@
+/**
+ * @file ingest.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.1
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the ingest queue (lock-free ring after D. Vyukov's bounded queue).
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for string manipulation (e.g., memcpy, strchr)
+
+#include "ingest.h"
+#include "occurrences.h"
+#include "symbols.h"
+#include "datetime.h"
+
+/**
+ * @brief Parses a whole number in [min, max] ending at a ';' (or the end of the text).
+ */
+static const char* parseField(const char* text, int min, int max, int* value) {
+    char* end;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || parsed < min || parsed > max) return NULL;
+    while (*end == ' ') end++;
+    if (*end != ';') return NULL;
+    *value = (int) parsed;
+    return end + 1;
+}
+
+/**
+ * @brief Parses a report written "location;type;priority;dd/mm/yyyy hh:mm".
+ */
+int ingestParse(const char* text, IngestRecord* record) {
+    const char* location = text;
+    const char* separator = strchr(text, ';');
+    const char* cursor;
+    size_t length;
+    int type, priority;
+
+    if (!separator) return 0;
+    while (*location == ' ') location++;
+    length = separator > location ? (size_t) (separator - location) : 0;
+    while (length > 0 && location[length - 1] == ' ') length--;
+    if (length == 0 || length >= MAX_STRING) return 0;
+
+    cursor = parseField(separator + 1, 0, 2, &type);
+    if (!cursor) return 0;
+    cursor = parseField(cursor, 0, 2, &priority);
+    if (!cursor || !parseTimestamp(cursor, &record->timestamp)) return 0;
+
+    memcpy(record->location, location, length);
+    record->location[length] = '\0';
+    record->type = (OccurrenceType) type;
+    record->priority = (Priority) priority;
+    return 1;
+}
+
+// The ring uses the GCC/Clang atomic builtins; other compilers fall back to one mutex, which is
+// correct but makes producers and the applier take turns.
+#if defined(__GNUC__)
+static unsigned long atomicLoad(unsigned long* value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static void atomicStore(unsigned long* value, unsigned long desired) {
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+}
+
+static int atomicCompareExchange(unsigned long* value, unsigned long* expected, unsigned long desired) {
+    return __atomic_compare_exchange_n(value, expected, desired, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+static void atomicIncrement(unsigned long* value) {
+    __atomic_add_fetch(value, 1, __ATOMIC_RELAXED);
+}
+
+static void atomicFence(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+#else
+static pthread_mutex_t atomicLock = PTHREAD_MUTEX_INITIALIZER;
+
+static unsigned long atomicLoad(unsigned long* value) {
+    unsigned long current;
+    pthread_mutex_lock(&atomicLock);
+    current = *value;
+    pthread_mutex_unlock(&atomicLock);
+    return current;
+}
+
+static void atomicStore(unsigned long* value, unsigned long desired) {
+    pthread_mutex_lock(&atomicLock);
+    *value = desired;
+    pthread_mutex_unlock(&atomicLock);
+}
+
+static int atomicCompareExchange(unsigned long* value, unsigned long* expected, unsigned long desired) {
+    int swapped;
+    pthread_mutex_lock(&atomicLock);
+    swapped = *value == *expected;
+    if (swapped) *value = desired;
+    else *expected = *value;
+    pthread_mutex_unlock(&atomicLock);
+    return swapped;
+}
+
+static void atomicIncrement(unsigned long* value) {
+    pthread_mutex_lock(&atomicLock);
+    (*value)++;
+    pthread_mutex_unlock(&atomicLock);
+}
+
+static void atomicFence(void) {
+    pthread_mutex_lock(&atomicLock);
+    pthread_mutex_unlock(&atomicLock);
+}
+#endif
+
+/**
+ * @brief Claims the next free slot and fills it; returns 0 if the ring is full.
+ */
+static int ringPush(IngestRing* ring, const IngestRecord* record) {
+    unsigned long position = atomicLoad(&ring->tail);
+    IngestSlot* slot;
+
+    for (;;) {
+        long difference;
+        slot = &ring->slots[position & ring->mask];
+        difference = (long) (atomicLoad(&slot->sequence) - position);
+        if (difference == 0) {
+            // The slot is free for this position: claim it (on failure position is reloaded).
+            if (atomicCompareExchange(&ring->tail, &position, position + 1)) break;
+        } else if (difference < 0) {
+            return 0; // The consumer has not read this slot yet: full.
+        } else {
+            position = atomicLoad(&ring->tail);
+        }
+    }
+    slot->record = *record;
+    // Publish: the consumer reads the record only after it sees this sequence.
+    atomicStore(&slot->sequence, position + 1);
+    return 1;
+}
+
+/**
+ * @brief Tells whether the oldest record is published (single consumer).
+ */
+static int ringReady(IngestRing* ring) {
+    return atomicLoad(&ring->slots[ring->head & ring->mask].sequence) == ring->head + 1;
+}
+
+/**
+ * @brief Takes the oldest published record (single consumer); returns 0 if there is none.
+ */
+static int ringPop(IngestRing* ring, IngestRecord* record) {
+    IngestSlot* slot = &ring->slots[ring->head & ring->mask];
+    if (!ringReady(ring)) return 0;
+    *record = slot->record;
+    // Hand the slot back to the producers for the next lap.
+    atomicStore(&slot->sequence, ring->head + ring->mask + 1);
+    atomicStore(&ring->head, ring->head + 1);
+    return 1;
+}
+
+/**
+ * @brief Blocks the applier until a report is published or the queue is stopped.
+ *
+ * waiting is raised before the ring is checked again, and a producer checks it after publishing,
+ * so either the applier sees the report or the producer sees waiting and signals.
+ */
+static void waitForReports(IngestQueue* queue) {
+    pthread_mutex_lock(&queue->wakeLock);
+    atomicStore(&queue->waiting, 1);
+    atomicFence();
+    while (!ringReady(&queue->ring) && !atomicLoad(&queue->stopping)) {
+        pthread_cond_wait(&queue->wake, &queue->wakeLock);
+    }
+    atomicStore(&queue->waiting, 0);
+    pthread_mutex_unlock(&queue->wakeLock);
+}
+
+/**
+ * @brief Wakes the applier if it is blocked in waitForReports.
+ */
+static void wakeApplier(IngestQueue* queue) {
+    atomicFence();
+    if (!atomicLoad(&queue->waiting)) return;
+    pthread_mutex_lock(&queue->wakeLock);
+    pthread_cond_signal(&queue->wake);
+    pthread_mutex_unlock(&queue->wakeLock);
+}
+
+/**
+ * @brief Body of the applier: drains the ring in batches until it is stopped and empty.
+ */
+static void* applierMain(void* argument) {
+    IngestQueue* queue = (IngestQueue*) argument;
+    IngestRecord* batch = queue->batch;
+    int idle = 0;
+
+    for (;;) {
+        int n = 0, i;
+        while (n < INGEST_BATCH && ringPop(&queue->ring, &batch[n])) n++;
+
+        if (n == 0) {
+            if (atomicLoad(&queue->stopping)) {
+                // Producers are done; one more look catches reports published meanwhile.
+                if (!ringPop(&queue->ring, &batch[0])) break;
+                n = 1;
+            } else {
+                // Spin briefly for bursts, then block until a producer signals.
+                if (++idle >= INGEST_SPINS) {
+                    waitForReports(queue);
+                    idle = 0;
+                }
+                continue;
+            }
+        }
+        idle = 0;
+
+        if (queue->lock) queue->lock(queue->lockContext, 1);
+        for (i = 0; i < n; i++) {
+            if (addOccurrence(queue->store, queue->idSeq, internString(batch[i].location), batch[i].type,
+                              batch[i].priority, batch[i].timestamp)) {
+                atomicIncrement(&queue->applied);
+            } else {
+                atomicIncrement(&queue->rejected);
+            }
+        }
+        if (queue->lock) queue->lock(queue->lockContext, 0);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Frees the ring and the batch buffer of a queue.
+ */
+static void releaseQueue(IngestQueue* queue) {
+    free(queue->ring.slots);
+    free(queue->batch);
+    queue->ring.slots = NULL;
+    queue->batch = NULL;
+    pthread_cond_destroy(&queue->wake);
+    pthread_mutex_destroy(&queue->wakeLock);
+}
+
+/**
+ * @brief Creates the ring and starts the applier thread.
+ */
+int ingestStart(IngestQueue* queue, int capacity, OccurrenceStore* store, int* idSeq,
+                IngestLock lock, void* lockContext) {
+    unsigned long size = 2;
+    unsigned long i;
+
+    while (size < (unsigned long) capacity) size *= 2;
+    memset(queue, 0, sizeof(IngestQueue));
+    pthread_mutex_init(&queue->wakeLock, NULL);
+    pthread_cond_init(&queue->wake, NULL);
+    queue->ring.slots = (IngestSlot*) malloc(sizeof(IngestSlot) * size);
+    // Allocated here so a missing buffer fails the start instead of stopping the applier later.
+    queue->batch = (IngestRecord*) malloc(sizeof(IngestRecord) * INGEST_BATCH);
+    if (!queue->ring.slots || !queue->batch) {
+        releaseQueue(queue);
+        return 0;
+    }
+    for (i = 0; i < size; i++) queue->ring.slots[i].sequence = i;
+    queue->ring.mask = size - 1;
+    queue->store = store;
+    queue->idSeq = idSeq;
+    queue->lock = lock;
+    queue->lockContext = lockContext;
+
+    if (pthread_create(&queue->applier, NULL, applierMain, queue) != 0) {
+        releaseQueue(queue);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Pushes a report without blocking.
+ */
+int ingestSubmit(IngestQueue* queue, const IngestRecord* record) {
+    if (!ringPush(&queue->ring, record)) {
+        atomicIncrement(&queue->rejected);
+        return 0;
+    }
+    atomicIncrement(&queue->submitted);
+    wakeApplier(queue);
+    return 1;
+}
+
+/**
+ * @brief Returns the number of reports queued but not yet applied.
+ */
+int ingestBacklog(IngestQueue* queue) {
+    unsigned long tail = atomicLoad(&queue->ring.tail);
+    unsigned long head = atomicLoad(&queue->ring.head);
+    return tail > head ? (int) (tail - head) : 0;
+}
+
+/**
+ * @brief Reads the counters of the queue.
+ */
+void ingestCounters(IngestQueue* queue, unsigned long* submitted, unsigned long* applied, unsigned long* rejected) {
+    *submitted = atomicLoad(&queue->submitted);
+    *applied = atomicLoad(&queue->applied);
+    *rejected = atomicLoad(&queue->rejected);
+}
+
+/**
+ * @brief Applies every queued report, stops the applier and frees the ring.
+ */
+void ingestStop(IngestQueue* queue) {
+    if (!queue->ring.slots) return;
+    atomicStore(&queue->stopping, 1);
+    pthread_mutex_lock(&queue->wakeLock);
+    pthread_cond_signal(&queue->wake);
+    pthread_mutex_unlock(&queue->wakeLock);
+    pthread_join(queue->applier, NULL);
+    releaseQueue(queue);
+}
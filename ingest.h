@@ -0,0 +1,156 @@
+/**
+ * @file ingest.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.1
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the ingest queue: occurrence reports from many threads, applied by one.
+ *
+ * Producers (server clients, file tailers, ...) push reports into a bounded lock-free ring and
+ * return at once; pushing never waits for the stores. A single applier thread drains the ring
+ * and adds the reports to the occurrence store in batches, taking the store lock once per batch
+ * instead of once per report. When the ring stays empty the applier blocks on a condition variable
+ * that producers signal, so an idle queue costs no CPU.
+ *
+ * The ring relies on the GCC/Clang __atomic builtins; with other compilers every atomic operation
+ * falls back to a mutex.
+ */
+
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <pthread.h> // Provides pthread_t, pthread_mutex_t and pthread_cond_t
+
+#include "data.h"
+
+/**
+ * @brief Most reports applied under one acquisition of the store lock.
+ */
+#define INGEST_BATCH 256
+
+/**
+ * @brief Empty polls of the ring before the applier blocks (absorbs bursts without a wake-up).
+ */
+#define INGEST_SPINS 64
+
+/**
+ * @brief An occurrence report waiting to be applied (the location is interned by the applier).
+ */
+typedef struct {
+    char location[MAX_STRING];
+    OccurrenceType type;
+    Priority priority;
+    Timestamp timestamp;
+} IngestRecord;
+
+/**
+ * @brief Slot of the ring: a record and the sequence number telling whose turn it is.
+ */
+typedef struct {
+    unsigned long sequence;
+    IngestRecord record;
+} IngestSlot;
+
+/**
+ * @brief Bounded multi-producer single-consumer ring (capacity is a power of two).
+ *
+ * The producer and consumer positions sit on separate cache lines, so producers claiming
+ * slots do not slow down the consumer and vice versa.
+ */
+typedef struct {
+    IngestSlot* slots;
+    unsigned long mask;
+    char padding0[64];
+    unsigned long tail; /**< Next position to claim (producers, atomic). */
+    char padding1[64];
+    unsigned long head; /**< Next position to read (written by the consumer only). */
+    char padding2[64];
+} IngestRing;
+
+/**
+ * @brief Locks (acquire 1) or unlocks (acquire 0) the stores the applier changes.
+ */
+typedef void (*IngestLock)(void* context, int acquire);
+
+/**
+ * @brief Ingest queue: the ring plus its applier thread.
+ */
+typedef struct {
+    IngestRing ring;
+    OccurrenceStore* store;
+    int* idSeq;
+    IngestLock lock;
+    void* lockContext;
+    IngestRecord* batch;       /**< Reports taken from the ring by the applier (INGEST_BATCH slots). */
+    pthread_t applier;
+    pthread_mutex_t wakeLock;  /**< Guards the wake-up of the applier. */
+    pthread_cond_t wake;       /**< Signalled when a report is published while the applier waits. */
+    unsigned long waiting;     /**< Set (atomically) while the applier is blocked on wake. */
+    unsigned long stopping;    /**< Set (atomically) to make the applier drain the ring and exit. */
+    unsigned long submitted;   /**< Reports pushed (atomic). */
+    unsigned long rejected;    /**< Reports refused: ring full, or not accepted by the store (atomic). */
+    unsigned long applied;     /**< Reports added to the store (atomic). */
+} IngestQueue;
+
+/**
+ * @brief Parses a report written "location;type;priority;dd/mm/yyyy hh:mm".
+ *
+ * @param text Text of the report.
+ * @param record Pointer to receive the report.
+ * @return Returns 1 on success, 0 if the text is not a valid report.
+ */
+int ingestParse(const char* text, IngestRecord* record);
+
+/**
+ * @brief Creates the ring and starts the applier thread.
+ *
+ * @param queue Pointer to the queue.
+ * @param capacity Number of slots (rounded up to a power of two).
+ * @param store Occurrence store receiving the reports.
+ * @param idSeq Occurrence ID counter.
+ * @param lock Function locking the stores around each batch (NULL if nothing else uses them).
+ * @param lockContext Argument passed to lock.
+ * @return Returns 1 on success, 0 if memory or the thread could not be obtained.
+ */
+int ingestStart(IngestQueue* queue, int capacity, OccurrenceStore* store, int* idSeq,
+                IngestLock lock, void* lockContext);
+
+/**
+ * @brief Pushes a report without blocking (safe from any number of threads).
+ *
+ * @param queue Pointer to the queue.
+ * @param record Report to push.
+ * @return Returns 1 if it was queued, 0 if the ring is full (the caller may retry later).
+ */
+int ingestSubmit(IngestQueue* queue, const IngestRecord* record);
+
+/**
+ * @brief Returns the number of reports queued but not yet applied.
+ *
+ * @param queue Pointer to the queue.
+ * @return Returns the approximate backlog.
+ */
+int ingestBacklog(IngestQueue* queue);
+
+/**
+ * @brief Reads the counters of the queue (safe while producers and the applier run).
+ *
+ * @param queue Pointer to the queue.
+ * @param submitted Pointer to receive the reports pushed.
+ * @param applied Pointer to receive the reports added to the store.
+ * @param rejected Pointer to receive the reports refused.
+ */
+void ingestCounters(IngestQueue* queue, unsigned long* submitted, unsigned long* applied, unsigned long* rejected);
+
+/**
+ * @brief Applies every queued report, stops the applier and frees the ring.
+ *
+ * No report may be submitted during or after the call.
+ *
+ * @param queue Pointer to the queue.
+ */
+void ingestStop(IngestQueue* queue);
+
+#endif // INGEST_H
@@ -11,207 +11,586 @@
 
 #include <stdio.h>   // Provides standard input and output functions (e.g., printf, scanf)
 #include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <limits.h>  // Provides the limits of the integer types (e.g., INT_MAX)
 
 #include "interventions.h"
+#include "firefighters.h"
+#include "equipments.h"
+#include "occurrences.h"
+#include "assignment.h"
+#include "statistics.h"
+#include "store.h"
+#include "journal.h"
+#include "datetime.h"
+#include "symbols.h"
 #include "input.h"
 
-/**
- * @brief Helper function to calculate the difference in minutes between two dates.
- */
-int diffMinutes(DateTime start, DateTime end) {
-    long t1 = start.year * 525600 + start.month * 43200 + start.day * 1440 + start.hour * 60 + start.minute;
-    long t2 = end.year * 525600 + end.month * 43200 + end.day * 1440 + end.hour * 60 + end.minute;
-    return (int)(t2 - t1);
-}
+#define INTERVENTIONS_MAGIC 0x52544E49 // "INTR"
+#define INTERVENTIONS_VERSION 1
+
+// Batch assignment costs. Leaving an occurrence unattended costs more than any real assignment,
+// and more for higher priorities, so scarce firefighters go to the most urgent occurrences.
+static const long UNATTENDED_COST[] = { 1000, 3000, 9000 };
+#define SPECIALTY_MISMATCH_COST 500
+#define WORKLOAD_COST 10        // Per intervention already done by the firefighter
+#define MAX_WORKLOAD_COST 400
+#define CONFLICT_COST 1000000   // Firefighter already booked: never chosen over leaving it unattended
+#define ASSIGNMENT_BATCH 64     // Most urgent pending occurrences matched per batch assignment
+
+// Interventions without an end date are still open: their window extends to the end of time.
+#define OPEN_END INT_MAX
 
 /**
  * @brief Displays the Intervention management menu.
  */
-void menuInterventions(InterventionNode** head, OccurrenceNode* occHead, FirefighterNode* fireHead, EquipmentNode* equipHead, int* idSeq) {
+void menuInterventions(InterventionStore* store, OccurrenceStore* occurrences, FirefighterStore* firefighters, EquipmentStore* equipments, int* idSeq) {
     int op;
     do {
         printf("\n--- GESTÃO DE INTERVENÇÕES ---\n");
         printf("1. Criar Intervenção\n2. Listar Intervenções\n3. Atualizar Estado\n4. Cancelar Intervenção\n");
-        printf("5. Relatório de Estatísticas e Eficiência\n0. Voltar\n");
-        op = getInt(0, 5, "Opção: ");
+        printf("5. Relatório de Estatísticas e Eficiência\n6. Atribuição Automática de Ocorrências Pendentes\n");
+        printf("7. Bombeiros Livres num Período\n0. Voltar\n");
+        op = getInt(0, 7, "Opção: ");
 
         switch (op) {
             case 1:
-                *head = createIntervention(*head, occHead, fireHead, equipHead, idSeq);
+                createIntervention(store, occurrences, firefighters, equipments, idSeq);
             break;
             case 2:
-                listInterventions(*head);
+                listInterventions(store);
             break;
             case 3:
-                updateIntervention(*head);
+                updateIntervention(store, firefighters, equipments);
             break;
             case 4:
-                *head = deleteIntervention(*head);
+                deleteIntervention(store, firefighters, equipments);
             break;
             case 5:
-                reportInterventionStats(*head);
+                reportInterventionStats(store);
+            break;
+            case 6:
+                printf("--- Data de Início ---\n");
+                assignPendingOccurrences(store, occurrences, firefighters, equipments, readDateTime(), idSeq);
+            break;
+            case 7: {
+                printf("Data inicial:\n");
+                Timestamp from = readDateTime();
+                printf("Data final:\n");
+                Timestamp to = readDateTime();
+                listFreeFirefighters(store, firefighters, from, to);
+            }
             break;
         }
     } while (op != 0);
 }
 
 /**
- * @brief Creates a new intervention linked to resources.
+ * @brief Books the window of an intervention for its firefighter, or drops it once cancelled.
+ */
+static void trackSchedule(InterventionStore* store, int slot) {
+    const Intervention* record = &store->items[slot];
+    Timestamp end = record->end == NO_TIMESTAMP ? OPEN_END : record->end;
+    int member;
+
+    if (end <= record->start) end = record->start + 1;
+    // Each crew member has its own booking, numbered slot * MAX_CREW + position in the crew.
+    for (member = 0; member < MAX_CREW; member++) {
+        int item = slot * MAX_CREW + member;
+        if (record->status == INTERVENTION_INACTIVE || member >= record->crewCount) scheduleClear(&store->schedule, item);
+        else scheduleSet(&store->schedule, item, record->crew[member], record->start, end);
+    }
+}
+
+/**
+ * @brief Updates the duration histograms after a change to an intervention.
+ *
+ * Durations are classified by the type and priority of the occurrence when the intervention is recorded.
+ */
+static void trackDuration(InterventionStore* store, int slot) {
+    const Intervention* record = &store->items[slot];
+    int occurrence = store->occurrences ? idIndexGet(&store->occurrences->index, record->idOccurrence) : -1;
+
+    if (record->status == FINISHED && record->end > record->start && occurrence >= 0) {
+        const Occurrence* linked = &store->occurrences->items[occurrence];
+        histogramGridTrack(&store->durations, slot, TYPE_PRIORITY_CELL(linked->type, linked->priority),
+                           record->end - record->start);
+    } else {
+        histogramGridTrack(&store->durations, slot, -1, 0);
+    }
+}
+
+/**
+ * @brief Hands the crew and equipment of an intervention back (AVAILABLE / OPERATIONAL).
+ */
+static void releaseResources(const Intervention* record, FirefighterStore* firefighters, EquipmentStore* equipments) {
+    int i;
+    for (i = 0; i < record->crewCount; i++) {
+        Firefighter* member = findFirefighter(firefighters, record->crew[i]);
+        if (member && member->status == BUSY) {
+            setFirefighterStatus(firefighters, member, AVAILABLE);
+            touchFirefighter(firefighters, member);
+        }
+    }
+    for (i = 0; i < record->equipmentCount; i++) {
+        Equipment* item = findEquipment(equipments, record->equipment[i]);
+        if (item && item->status == IN_USE) {
+            setEquipmentStatus(equipments, item, OPERATIONAL);
+            touchEquipment(equipments, item);
+        }
+    }
+}
+
+/**
+ * @brief Prints a list of resource IDs on one line.
+ */
+static void printIds(const char* label, const int* ids, int count) {
+    int i;
+    printf("%s:", label);
+    if (count == 0) printf(" nenhum");
+    for (i = 0; i < count; i++) printf(" %d", ids[i]);
+    printf("\n");
+}
+
+/**
+ * @brief Tells whether an ID is among the first count entries of an array.
+ */
+static int containsId(const int* ids, int count, int id) {
+    int i;
+    for (i = 0; i < count; i++) {
+        if (ids[i] == id) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Appends an intervention record to the store and indexes it by ID.
+ */
+Intervention* insertIntervention(InterventionStore* store, const Intervention* record) {
+    if (!storeReserve((void**) &store->items, &store->capacity, &store->mappedSize, store->count + 1, sizeof(Intervention))) return NULL;
+    if (!idIndexPut(&store->index, record->id, store->count)) return NULL;
+    store->items[store->count] = *record;
+    trackSchedule(store, store->count);
+    trackDuration(store, store->count);
+    return &store->items[store->count++];
+}
+
+/**
+ * @brief Replaces the intervention with the same ID or appends it.
  */
-InterventionNode* createIntervention(InterventionNode* head, OccurrenceNode* occHead, FirefighterNode* fireHead, EquipmentNode* equipHead, int* idSeq) {
-    InterventionNode* newNode = (InterventionNode*) malloc(sizeof(InterventionNode));
-    if (!newNode) return head;
+Intervention* upsertIntervention(InterventionStore* store, const Intervention* record) {
+    Intervention* existing = findIntervention(store, record->id);
+    if (!existing) return insertIntervention(store, record);
+
+    *existing = *record;
+    trackSchedule(store, (int) (existing - store->items));
+    trackDuration(store, (int) (existing - store->items));
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (existing - store->items));
+    return existing;
+}
 
+/**
+ * @brief Finds an intervention by ID in constant time.
+ */
+Intervention* findIntervention(InterventionStore* store, int id) {
+    int slot = idIndexGet(&store->index, id);
+    return slot < 0 ? NULL : &store->items[slot];
+}
+
+/**
+ * @brief Flags a modified intervention for the next save and journals it.
+ */
+void touchIntervention(InterventionStore* store, const Intervention* record) {
+    trackSchedule(store, (int) (record - store->items));
+    trackDuration(store, (int) (record - store->items));
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (record - store->items));
+    journalAppend(JOURNAL_INTERVENTION, record, sizeof(Intervention));
+}
+
+/**
+ * @brief Finds an active intervention of a firefighter that overlaps a window.
+ */
+const Intervention* findScheduleConflict(const InterventionStore* store, int firefighterId, Timestamp from, Timestamp to) {
+    int slot;
+    if (to == NO_TIMESTAMP) to = OPEN_END;
+    if (to <= from) to = from + 1;
+    slot = scheduleConflict(&store->schedule, firefighterId, from, to);
+    return slot < 0 ? NULL : &store->items[slot / MAX_CREW];
+}
+
+/**
+ * @brief Lists the active firefighters with no intervention overlapping a window.
+ */
+void listFreeFirefighters(const InterventionStore* store, const FirefighterStore* firefighters, Timestamp from, Timestamp to) {
+    char fromText[TIMESTAMP_TEXT], toText[TIMESTAMP_TEXT];
+    int i, found = 0;
+
+    formatTimestamp(from, fromText);
+    formatTimestamp(to, toText);
+    printf("\n=== BOMBEIROS LIVRES DE %s A %s ===\n", fromText, toText);
+    if (to < from) { printf("Intervalo inválido.\n"); return; }
+
+    for (i = 0; i < firefighters->count; i++) {
+        const Firefighter* current = &firefighters->items[i];
+        if (current->status == FIREFIGHTER_INACTIVE) continue;
+        if (findScheduleConflict(store, current->id, from, to)) continue;
+        printf("[%d] %s - %s%s\n", current->id, symbolText(current->name), symbolText(current->specialty),
+               current->status == BUSY ? " (ocupado agora)" : "");
+        found++;
+    }
+    printf("Total: %d bombeiro(s) livre(s).\n", found);
+}
+
+/**
+ * @brief Registers an intervention with its crew and equipment (no user interaction).
+ *
+ * The occurrence must exist, every crew member must be AVAILABLE and free from the start on,
+ * and every equipment item OPERATIONAL, with no repeated IDs. They become BUSY / IN_USE.
+ */
+Intervention* addIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments,
+                              int* idSeq, const Intervention* request) {
+    Intervention temp = *request;
+    Intervention* created;
+    int i;
+
+    if (!store->occurrences || idIndexGet(&store->occurrences->index, temp.idOccurrence) < 0) return NULL;
+    if (temp.crewCount < 1 || temp.crewCount > MAX_CREW) return NULL;
+    if (temp.equipmentCount < 0 || temp.equipmentCount > MAX_INTERVENTION_EQUIPMENT) return NULL;
+    for (i = 0; i < temp.crewCount; i++) {
+        Firefighter* member = findFirefighter(firefighters, temp.crew[i]);
+        if (!member || !bitsetTest(&firefighters->availableBits, (int) (member - firefighters->items)) ||
+            containsId(temp.crew, i, temp.crew[i]) || findScheduleConflict(store, temp.crew[i], temp.start, NO_TIMESTAMP)) {
+            return NULL;
+        }
+    }
+    for (i = 0; i < temp.equipmentCount; i++) {
+        Equipment* item = findEquipment(equipments, temp.equipment[i]);
+        if (!item || !bitsetTest(&equipments->operationalBits, (int) (item - equipments->items)) ||
+            containsId(temp.equipment, i, temp.equipment[i])) {
+            return NULL;
+        }
+    }
+
+    temp.id = *idSeq + 1;
+    temp.end = NO_TIMESTAMP;
+    temp.status = IN_PLANNING;
+    created = insertIntervention(store, &temp);
+    if (!created) return NULL;
     (*idSeq)++;
-    newNode->data.id = *idSeq;
+    touchIntervention(store, created);
 
-    int occId = getInt(1, 99999, "ID da Ocorrência Associada: ");
-    newNode->data.idOccurrence = occId;
+    for (i = 0; i < temp.crewCount; i++) {
+        Firefighter* member = findFirefighter(firefighters, temp.crew[i]);
+        member->totalInterventions++;
+        setFirefighterStatus(firefighters, member, BUSY);
+        touchFirefighter(firefighters, member);
+    }
+    for (i = 0; i < temp.equipmentCount; i++) {
+        Equipment* item = findEquipment(equipments, temp.equipment[i]);
+        setEquipmentStatus(equipments, item, IN_USE);
+        touchEquipment(equipments, item);
+    }
+    return created;
+}
+
+/**
+ * @brief Creates a new intervention linked to resources.
+ */
+Intervention* createIntervention(InterventionStore* store, OccurrenceStore* occurrences, FirefighterStore* firefighters, EquipmentStore* equipments, int* idSeq) {
+    Intervention temp;
+    Intervention* created;
+    int suggested[MAX_CREW];
+    int i, n, type = -1;
+
+    int occId = getInt(1, MAX_ID, "ID da Ocorrência Associada: ");
+    temp.idOccurrence = occId;
+    Occurrence* occurrence = findOccurrence(occurrences, occId);
+    if (!occurrence) {
+        printf("Ocorrência não encontrada.\n");
+        return NULL;
+    }
+    type = occurrence->type;
 
     printf("--- Data de Início ---\n");
-    newNode->data.start.day = getInt(1,31,"Dia: ");
-    newNode->data.start.month = getInt(1,12,"Mês: ");
-    newNode->data.start.year = getInt(2020,2030,"Ano: ");
-    newNode->data.start.hour = getInt(0,23,"Hora: ");
-    newNode->data.start.minute = getInt(0,59,"Minuto: ");
-
-    newNode->data.end.day = 0;
-    newNode->data.end.year = 0;
-
-    printf("Atribuir ID do Bombeiro: ");
-    int fId = getInt(1, 99999, "");
-    newNode->data.assignedFirefighterId = fId;
-
-    while(fireHead) {
-        if(fireHead->data.id == fId) {
-            fireHead->data.totalInterventions++;
-            printf("Bombeiro %s atribuído.\n", fireHead->data.name);
-            break;
+    temp.start = readDateTime();
+
+    temp.end = NO_TIMESTAMP;
+
+    // Free resources suited to the occurrence come straight from the availability bitsets.
+    n = collectAvailableFirefighters(firefighters, type, MAX_CREW, suggested);
+    printIds("Bombeiros disponíveis com a especialidade", suggested, n);
+    temp.crewCount = getInt(1, MAX_CREW, "Número de bombeiros: ");
+    for (i = 0; i < temp.crewCount; i++) {
+        int fId = getInt(1, MAX_ID, "ID do Bombeiro: ");
+        Firefighter* member = findFirefighter(firefighters, fId);
+        const Intervention* conflict;
+
+        if (!member || !bitsetTest(&firefighters->availableBits, (int) (member - firefighters->items)) || containsId(temp.crew, i, fId)) {
+            printf("O bombeiro %d não está disponível.\n", fId);
+            return NULL;
         }
-        fireHead = fireHead->next;
+        // An open intervention occupies the firefighter from its start on.
+        conflict = findScheduleConflict(store, fId, temp.start, NO_TIMESTAMP);
+        if (conflict) {
+            printf("O bombeiro %d já está atribuído à intervenção %d nesse período.\n", fId, conflict->id);
+            return NULL;
+        }
+        temp.crew[i] = fId;
+    }
+
+    n = collectOperationalEquipment(equipments, type, MAX_INTERVENTION_EQUIPMENT, suggested);
+    printIds("Equipamentos operacionais adequados", suggested, n);
+    temp.equipmentCount = getInt(0, MAX_INTERVENTION_EQUIPMENT, "Número de equipamentos: ");
+    for (i = 0; i < temp.equipmentCount; i++) {
+        int eId = getInt(1, MAX_ID, "ID do Equipamento: ");
+        Equipment* item = findEquipment(equipments, eId);
+
+        if (!item || !bitsetTest(&equipments->operationalBits, (int) (item - equipments->items)) || containsId(temp.equipment, i, eId)) {
+            printf("O equipamento %d não está operacional.\n", eId);
+            return NULL;
+        }
+        temp.equipment[i] = eId;
+    }
+
+    created = addIntervention(store, firefighters, equipments, idSeq, &temp);
+    if (!created) return NULL;
+
+    for (i = 0; i < temp.crewCount; i++) {
+        printf("Bombeiro %s atribuído.\n", symbolText(findFirefighter(firefighters, temp.crew[i])->name));
     }
 
-    newNode->data.status = IN_PLANNING;
-    newNode->next = head;
     printf("Intervenção %d criada.\n", *idSeq);
-    return newNode;
+    return created;
+}
+
+/**
+ * @brief Cost of sending a firefighter to an occurrence in the batch assignment.
+ */
+static long assignmentCost(const Occurrence* occurrence, const Firefighter* firefighter) {
+    long workload = (long) firefighter->totalInterventions * WORKLOAD_COST;
+    long cost = workload < MAX_WORKLOAD_COST ? workload : MAX_WORKLOAD_COST;
+    if (!textMatchesType(firefighter->specialty, occurrence->type)) cost += SPECIALTY_MISMATCH_COST;
+    return cost;
+}
+
+/**
+ * @brief Assigns the most urgent pending occurrences to the available firefighters in one operation.
+ *
+ * Builds a cost matrix with one row per REPORTED occurrence (at most ASSIGNMENT_BATCH, taken from
+ * the front of the dispatch queue) and one column per AVAILABLE firefighter, plus one "unattended"
+ * column per occurrence, and solves it with the Hungarian algorithm, so the matching is globally
+ * optimal instead of first-come first-served. Each match goes through addIntervention.
+ */
+int assignPendingOccurrences(InterventionStore* store, OccurrenceStore* occurrences, FirefighterStore* firefighters,
+                             EquipmentStore* equipments, Timestamp start, int* idSeq) {
+    int pending[ASSIGNMENT_BATCH];
+    int* available;
+    int* assignment;
+    long* cost;
+    int rows, cols, freeCount = firefighters->available.count;
+    int i, j, created = 0;
+
+    if (occurrences->dispatch.count == 0 || freeCount == 0) {
+        printf(occurrences->dispatch.count == 0 ? "Sem ocorrências pendentes.\n" : "Sem bombeiros disponíveis.\n");
+        return 0;
+    }
+
+    // The dispatch queue holds exactly the REPORTED occurrences, most urgent first, and the
+    // availability queue exactly the AVAILABLE firefighters.
+    rows = heapFirst(&occurrences->dispatch, ASSIGNMENT_BATCH, pending);
+    cols = freeCount + rows;
+    available = (int*) malloc(sizeof(int) * freeCount);
+    cost = (long*) calloc((size_t) rows * cols, sizeof(long));
+    assignment = (int*) malloc(sizeof(int) * rows);
+    if (!available || !cost || !assignment) {
+        printf("Memória insuficiente para a atribuição.\n");
+        free(available); free(cost); free(assignment);
+        return 0;
+    }
+    for (j = 0; j < freeCount; j++) available[j] = firefighters->available.items[j];
+
+    for (i = 0; i < rows; i++) {
+        const Occurrence* occurrence = &occurrences->items[pending[i]];
+        for (j = 0; j < freeCount; j++) {
+            const Firefighter* firefighter = &firefighters->items[available[j]];
+            cost[(long) i * cols + j] = findScheduleConflict(store, firefighter->id, start, NO_TIMESTAMP)
+                                            ? CONFLICT_COST : assignmentCost(occurrence, firefighter);
+        }
+        for (j = freeCount; j < cols; j++) cost[(long) i * cols + j] = UNATTENDED_COST[occurrence->priority];
+    }
+
+    if (!solveAssignment(cost, rows, cols, assignment)) {
+        printf("Memória insuficiente para a atribuição.\n");
+        rows = 0;
+    }
+    for (i = 0; i < rows; i++) {
+        Occurrence* occurrence = &occurrences->items[pending[i]];
+        Intervention request;
+        Intervention* intervention;
+
+        if (assignment[i] >= freeCount || cost[(long) i * cols + assignment[i]] >= CONFLICT_COST) continue;
+
+        request.idOccurrence = occurrence->id;
+        request.start = start;
+        request.crew[0] = firefighters->items[available[assignment[i]]].id;
+        request.crewCount = 1;
+        request.equipmentCount = 0;
+        intervention = addIntervention(store, firefighters, equipments, idSeq, &request);
+        if (!intervention) continue;
+
+        occurrence->status = IN_PROGRESS;
+        touchOccurrence(occurrences, occurrence);
+
+        printf("Intervenção %d: Ocorrência %d <- Bombeiro %s\n", intervention->id, occurrence->id,
+               symbolText(firefighters->items[available[assignment[i]]].name));
+        created++;
+    }
+    printf("%d intervenção(ões) criada(s); %d ocorrência(s) por atribuir.\n", created, occurrences->dispatch.count);
+
+    free(available); free(cost); free(assignment);
+    return created;
 }
 
 /**
  * @brief Lists all interventions.
  */
-void listInterventions(InterventionNode* head) {
-    if(!head) { printf("Sem intervenções.\n"); return; }
-    printf("\nID | OCORRÊNCIA | ESTADO\n");
-    while(head) {
+void listInterventions(const InterventionStore* store) {
+    int i;
+    if(store->count == 0) { printf("Sem intervenções.\n"); return; }
+    printf("\nID | OCORRÊNCIA | ESTADO | EQUIPA | EQUIPAMENTOS\n");
+    for (i = 0; i < store->count; i++) {
+        const Intervention* current = &store->items[i];
         char statusStr[20];
-        if(head->data.status == IN_PLANNING) sprintf(statusStr, "Planeamento");
-        else if(head->data.status == RUNNING) sprintf(statusStr, "Em Curso");
+        if(current->status == IN_PLANNING) sprintf(statusStr, "Planeamento");
+        else if(current->status == RUNNING) sprintf(statusStr, "Em Curso");
         else sprintf(statusStr, "Concluída");
 
-        if(head->data.status != INTERVENTION_INACTIVE)
-             printf("%d | %d | %s\n", head->data.id, head->data.idOccurrence, statusStr);
-        head = head->next;
+        if(current->status != INTERVENTION_INACTIVE) {
+            int k;
+            printf("%d | %d | %s |", current->id, current->idOccurrence, statusStr);
+            for (k = 0; k < current->crewCount; k++) printf(" %d", current->crew[k]);
+            printf(" |");
+            for (k = 0; k < current->equipmentCount; k++) printf(" %d", current->equipment[k]);
+            printf("\n");
+        }
+    }
+}
+
+/**
+ * @brief Changes the status of an intervention by ID (no user interaction).
+ *
+ * Finishing an open intervention sets its end date and releases its crew and equipment. Closed
+ * interventions stay closed: their resources were handed back and may be booked elsewhere.
+ */
+int changeInterventionStatus(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments,
+                             int id, InterventionStatus status, Timestamp end) {
+    Intervention* current = findIntervention(store, id);
+    if (!current || (current->status != IN_PLANNING && current->status != RUNNING)) return 0;
+    if (status == INTERVENTION_INACTIVE) return cancelIntervention(store, firefighters, equipments, id);
+    if (status == FINISHED && (end == NO_TIMESTAMP || end < current->start)) return 0;
+
+    current->status = status;
+    if (status == FINISHED) {
+        current->end = end;
+        releaseResources(current, firefighters, equipments);
     }
+    touchIntervention(store, current);
+    return 1;
+}
+
+/**
+ * @brief Cancels an intervention by ID, releasing its resources (no user interaction).
+ */
+int cancelIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments, int id) {
+    Intervention* current = findIntervention(store, id);
+    if (!current) return 0;
+    if (current->status == IN_PLANNING || current->status == RUNNING) releaseResources(current, firefighters, equipments);
+    current->status = INTERVENTION_INACTIVE;
+    touchIntervention(store, current);
+    return 1;
 }
 
 /**
  * @brief Updates the status of an intervention.
  */
-void updateIntervention(InterventionNode* head) {
-    int id = getInt(1, 99999, "ID da Intervenção: ");
-    while(head) {
-        if(head->data.id == id) {
-            printf("Novo Estado (0-Planeamento, 1-Em Curso, 2-Concluída): ");
-            int st = getInt(0, 2, "");
-            head->data.status = (InterventionStatus)st;
-            if(st == 2) {
-                printf("--- Data de Fim ---\n");
-                head->data.end.day = getInt(1,31,"Dia: ");
-                head->data.end.hour = getInt(0,23,"Hora: ");
-                head->data.end.minute = getInt(0,59,"Minuto: ");
-            }
-            return;
+void updateIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments) {
+    int id = getInt(1, MAX_ID, "ID da Intervenção: ");
+    Intervention* current = findIntervention(store, id);
+    if(current) {
+        printf("Novo Estado (0-Planeamento, 1-Em Curso, 2-Concluída): ");
+        int st = getInt(0, 2, "");
+        Timestamp end = current->end;
+        if(st == 2) {
+            printf("--- Data de Fim ---\n");
+            end = readDateTime();
+        }
+        if (!changeInterventionStatus(store, firefighters, equipments, id, (InterventionStatus) st, end)) {
+            printf("Alteração recusada: a intervenção já está fechada ou o fim é anterior ao início.\n");
         }
-        head = head->next;
     }
 }
 
 /**
  * @brief Cancels an intervention.
  */
-InterventionNode* deleteIntervention(InterventionNode* head) {
-    int id = getInt(1, 99999, "ID a cancelar: ");
-    InterventionNode* current = head;
-    while(current) {
-        if(current->data.id == id) {
-            current->data.status = INTERVENTION_INACTIVE;
-            printf("Intervenção cancelada.\n");
-            return head;
-        }
-        current = current->next;
+void deleteIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments) {
+    int id = getInt(1, MAX_ID, "ID a cancelar: ");
+    if(cancelIntervention(store, firefighters, equipments, id)) {
+        printf("Intervenção cancelada.\n");
+        return;
     }
     printf("ID não encontrado.\n");
-    return head;
 }
 
 /**
  * @brief REPORT: Efficiency Stats.
  */
-void reportInterventionStats(InterventionNode* head) {
+void reportInterventionStats(const InterventionStore* store) {
     printf("\n=== ESTATÍSTICAS DA INTERVENÇÃO ===\n");
-    int count = 0;
-    int totalDuration = 0;
-
-    while(head) {
-        if(head->data.status == FINISHED) {
-            int dur = diffMinutes(head->data.start, head->data.end);
-            if(dur > 0) {
-                totalDuration += dur;
-                count++;
-            }
-        }
-        head = head->next;
-    }
-
-    if(count > 0) printf("- Duração Média: %d minutos\n", totalDuration / count);
-    else printf("- Nenhuma intervenção concluída.\n");
+    printf("Duração das intervenções concluídas (minutos):\n");
+    printPercentileTable(&store->durations);
+}
 
-    printf("- Total Concluídas: %d\n", count);
+/**
+ * @brief Accepts a loaded record only if its status and resource counts are in range.
+ */
+static int validIntervention(const void* record) {
+    const Intervention* intervention = (const Intervention*) record;
+    return (int) intervention->status >= IN_PLANNING && (int) intervention->status <= INTERVENTION_INACTIVE &&
+           intervention->crewCount >= 0 && intervention->crewCount <= MAX_CREW &&
+           intervention->equipmentCount >= 0 && intervention->equipmentCount <= MAX_INTERVENTION_EQUIPMENT;
 }
 
-void saveInterventions(InterventionNode* head) {
-    FILE* fp = fopen(FILE_INTERVENTIONS, "wb");
-    if (!fp) return;
-    while(head) {
-        fwrite(&head->data, sizeof(Intervention), 1, fp);
-        head = head->next;
-    }
-    fclose(fp);
+int saveInterventions(InterventionStore* store) {
+    return storeFlush(FILE_INTERVENTIONS, INTERVENTIONS_MAGIC, INTERVENTIONS_VERSION, store->items, store->count, sizeof(Intervention), &store->dirty, &store->persistedCount);
 }
 
-InterventionNode* loadInterventions(int* idSeq) {
-    FILE* fp = fopen(FILE_INTERVENTIONS, "rb");
-    if (!fp) return NULL;
-    InterventionNode* head = NULL;
-    Intervention temp;
+void loadInterventions(InterventionStore* store, const OccurrenceStore* occurrences, int* idSeq) {
+    int i;
+
+    idIndexInit(&store->index);
+    scheduleInit(&store->schedule);
+    histogramGridInit(&store->durations, TYPE_PRIORITY_CELLS);
+    store->occurrences = occurrences;
     *idSeq = 0;
-    while(fread(&temp, sizeof(Intervention), 1, fp)){
-        InterventionNode* newNode = (InterventionNode*)malloc(sizeof(InterventionNode));
-        newNode->data = temp;
-        newNode->next = head;
-        head = newNode;
-        if(temp.id > *idSeq) *idSeq = temp.id;
+    storeLoad(FILE_INTERVENTIONS, INTERVENTIONS_MAGIC, INTERVENTIONS_VERSION, (void**) &store->items, &store->count, &store->capacity,
+              &store->mappedSize, sizeof(Intervention), validIntervention);
+    store->persistedCount = store->count;
+    store->dirty = (unsigned char*) calloc(store->count > 0 ? store->count : 1, 1);
+
+    for (i = 0; i < store->count; i++) {
+        idIndexPut(&store->index, store->items[i].id, i);
+        trackSchedule(store, i);
+        trackDuration(store, i);
+        if (store->items[i].id > *idSeq) *idSeq = store->items[i].id;
     }
-    fclose(fp);
-    return head;
 }
 
-void freeInterventions(InterventionNode* head) {
-    InterventionNode* temp;
-    while(head){
-        temp = head;
-        head = head->next;
-        free(temp);
-    }
-}
\ No newline at end of file
+void freeInterventions(InterventionStore* store) {
+    storeRelease((void**) &store->items, &store->count, &store->capacity, &store->mappedSize);
+    free(store->dirty);
+    store->dirty = NULL;
+    store->persistedCount = 0;
+    idIndexFree(&store->index);
+    scheduleFree(&store->schedule);
+    histogramGridFree(&store->durations);
+}
@@ -17,75 +17,227 @@
 /**
  * @brief Displays the Intervention management menu and handles user selection.
  *
- * @param head Double pointer to the head of the intervention linked list.
- * @param occHead Pointer to the head of the occurrence linked list (for linking).
- * @param fireHead Pointer to the head of the firefighter linked list (for assignment).
- * @param equipHead Pointer to the head of the equipment linked list (for assignment).
+ * @param store Pointer to the intervention store.
+ * @param occurrences Pointer to the occurrence store (for linking).
+ * @param firefighters Pointer to the firefighter store (for assignment).
+ * @param equipments Pointer to the equipment store (for assignment).
  * @param idSeq Pointer to the ID sequence counter.
  */
-void menuInterventions(InterventionNode** head, OccurrenceNode* occHead, FirefighterNode* fireHead, EquipmentNode* equipHead, int* idSeq);
+void menuInterventions(InterventionStore* store, OccurrenceStore* occurrences, FirefighterStore* firefighters, EquipmentStore* equipments, int* idSeq);
+
+/**
+ * @brief Registers an intervention with its crew and equipment, without user interaction.
+ *
+ * Applies the same rules as createIntervention: the occurrence must exist, every crew member
+ * must be AVAILABLE with no intervention overlapping the start, every item OPERATIONAL, and no
+ * ID may repeat. The crew becomes BUSY and the equipment IN_USE.
+ *
+ * @param store Pointer to the intervention store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param idSeq Pointer to the ID sequence counter.
+ * @param request Occurrence, start, crew and equipment of the intervention (the other fields are ignored).
+ * @return Returns the new intervention, or NULL if it was refused or memory could not be allocated.
+ */
+Intervention* addIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments,
+                              int* idSeq, const Intervention* request);
 
 /**
  * @brief Creates a new intervention linked to an occurrence and resources.
  *
- * @param head Pointer to the current head of the intervention linked list.
- * @param occHead Pointer to the head of the occurrence linked list.
- * @param fireHead Pointer to the head of the firefighter linked list.
- * @param equipHead Pointer to the head of the equipment linked list.
+ * The intervention carries a crew of up to MAX_CREW firefighters and up to
+ * MAX_INTERVENTION_EQUIPMENT equipment items. Free resources suited to the occurrence type are
+ * suggested from the availability bitsets. The intervention is refused if a crew member is not
+ * AVAILABLE or already has an intervention overlapping its start, or if an item is not OPERATIONAL.
+ * The crew becomes BUSY and the equipment IN_USE.
+ *
+ * @param store Pointer to the intervention store.
+ * @param occurrences Pointer to the occurrence store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param idSeq Pointer to the ID sequence counter.
+ * @return Returns the new intervention, or NULL if it was refused or memory could not be allocated.
+ */
+Intervention* createIntervention(InterventionStore* store, OccurrenceStore* occurrences, FirefighterStore* firefighters, EquipmentStore* equipments, int* idSeq);
+
+/**
+ * @brief Appends an intervention record to the store and indexes it by ID.
+ *
+ * @param store Pointer to the intervention store.
+ * @param record Record to copy into the store.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Intervention* insertIntervention(InterventionStore* store, const Intervention* record);
+
+/**
+ * @brief Stores a new version of a record: replaces the record with the same ID or appends it.
+ *
+ * Used when replaying the journal; keeps every structure derived from the store up to date.
+ *
+ * @param store Pointer to the intervention store.
+ * @param record New version of the record.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Intervention* upsertIntervention(InterventionStore* store, const Intervention* record);
+
+/**
+ * @brief Records that an intervention was modified: flags it for the next save and journals it.
+ *
+ * Must be called after every change to a record already in the store.
+ *
+ * @param store Pointer to the intervention store.
+ * @param record Pointer to the modified record (inside the store).
+ */
+void touchIntervention(InterventionStore* store, const Intervention* record);
+
+/**
+ * @brief Finds an active intervention of a firefighter that overlaps a time window.
+ *
+ * Each firefighter's interventions are kept in an interval tree (see schedule.h), so the check
+ * takes O(log n). Interventions without an end date count as open until further notice.
+ *
+ * @param store Pointer to the intervention store.
+ * @param firefighterId ID of the firefighter.
+ * @param from Start of the window.
+ * @param to End of the window (exclusive), or NO_TIMESTAMP for an open window.
+ * @return Returns an overlapping intervention, or NULL if the firefighter is free.
+ */
+const Intervention* findScheduleConflict(const InterventionStore* store, int firefighterId, Timestamp from, Timestamp to);
+
+/**
+ * @brief Lists the active firefighters with no intervention overlapping a time window.
+ *
+ * Answered from the interval trees: O(log n) per firefighter instead of a scan of all interventions.
+ *
+ * @param store Pointer to the intervention store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param from Start of the window.
+ * @param to End of the window.
+ */
+void listFreeFirefighters(const InterventionStore* store, const FirefighterStore* firefighters, Timestamp from, Timestamp to);
+
+/**
+ * @brief Assigns the most urgent pending occurrences to the available firefighters in one operation.
+ *
+ * Computes a global minimum-cost matching (Hungarian algorithm) between the first REPORTED
+ * occurrences of the dispatch queue (at most 64 per call, so the matrix stays small during large
+ * incidents) and the AVAILABLE firefighters. The cost favours a specialty matching the occurrence type and a
+ * low workload (totalInterventions), and leaving an occurrence unattended costs more the higher
+ * its priority. One intervention is created per match through addIntervention (so the firefighter
+ * becomes BUSY) and the occurrence becomes IN_PROGRESS.
+ *
+ * @param store Pointer to the intervention store.
+ * @param occurrences Pointer to the occurrence store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param start Start of the interventions created.
  * @param idSeq Pointer to the ID sequence counter.
- * @return Returns the new head of the linked list.
+ * @return Returns the number of interventions created.
  */
-InterventionNode* createIntervention(InterventionNode* head, OccurrenceNode* occHead, FirefighterNode* fireHead, EquipmentNode* equipHead, int* idSeq);
+int assignPendingOccurrences(InterventionStore* store, OccurrenceStore* occurrences, FirefighterStore* firefighters,
+                             EquipmentStore* equipments, Timestamp start, int* idSeq);
 
 /**
  * @brief Lists all registered interventions in the console.
  *
- * @param head Pointer to the head of the intervention linked list.
+ * @param store Pointer to the intervention store.
  */
-void listInterventions(InterventionNode* head);
+void listInterventions(const InterventionStore* store);
+
+/**
+ * @brief Changes the status of an intervention, without user interaction.
+ *
+ * Finishing an open intervention sets its end date and hands its crew and equipment back.
+ * Only open interventions (IN_PLANNING or RUNNING) can change: FINISHED and cancelled ones are final.
+ *
+ * @param store Pointer to the intervention store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param id ID of the intervention.
+ * @param status New status.
+ * @param end End date (only used when the status is FINISHED; must not precede the start).
+ * @return Returns 1 on success, 0 if the intervention does not exist, is closed or the end is invalid.
+ */
+int changeInterventionStatus(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments,
+                             int id, InterventionStatus status, Timestamp end);
+
+/**
+ * @brief Cancels an intervention (soft delete), handing its resources back, without user interaction.
+ *
+ * @param store Pointer to the intervention store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param id ID of the intervention.
+ * @return Returns 1 on success, 0 if the intervention does not exist.
+ */
+int cancelIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments, int id);
 
 /**
  * @brief Updates the status or details (e.g., end date) of an intervention.
  *
- * @param head Pointer to the head of the intervention linked list.
+ * Finishing an open intervention makes its crew AVAILABLE and its equipment OPERATIONAL again.
+ *
+ * @param store Pointer to the intervention store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
  */
-void updateIntervention(InterventionNode* head);
+void updateIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments);
 
 /**
  * @brief Cancels an intervention (Soft Delete / Inactive status).
  *
- * @param head Pointer to the head of the intervention linked list.
- * @return Returns the head of the linked list.
+ * Cancelling an open intervention hands its crew and equipment back.
+ *
+ * @param store Pointer to the intervention store.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
  */
-InterventionNode* deleteIntervention(InterventionNode* head);
+void deleteIntervention(InterventionStore* store, FirefighterStore* firefighters, EquipmentStore* equipments);
 
 /**
  * @brief REPORT: Generates statistics on efficiency, duration, and resource usage.
  *
- * @param head Pointer to the head of the intervention linked list.
+ * Prints the mean and the p50/p90/p95/p99 durations per occurrence type and priority, read from
+ * histograms kept current as interventions finish (constant time in the number of interventions).
+ *
+ * @param store Pointer to the intervention store.
  */
-void reportInterventionStats(InterventionNode* head);
+void reportInterventionStats(const InterventionStore* store);
 
 /**
- * @brief Saves the intervention list to a binary file.
+ * @brief Saves the intervention store to a binary file.
+ *
+ * Only records changed since the last save are rewritten (in place); new records are appended.
  *
- * @param head Pointer to the head of the intervention linked list.
+ * @param store Pointer to the intervention store.
+ * @return Returns 1 on success, 0 if the file could not be written.
  */
-void saveInterventions(InterventionNode* head);
+int saveInterventions(InterventionStore* store);
 
 /**
- * @brief Loads the intervention list from a binary file.
+ * @brief Loads the intervention store from a binary file.
  *
+ * @param store Pointer to the store to fill (always initialized, even if the file does not exist).
+ * @param occurrences Pointer to the (already loaded) occurrence store, used to classify durations.
  * @param idSeq Pointer to store the highest ID found.
- * @return Returns the pointer to the head of the loaded linked list.
  */
-InterventionNode* loadInterventions(int* idSeq);
+void loadInterventions(InterventionStore* store, const OccurrenceStore* occurrences, int* idSeq);
+
+/**
+ * @brief Finds an intervention by ID using the hash index (constant time).
+ *
+ * @param store Pointer to the intervention store.
+ * @param id ID of the intervention to find.
+ * @return Returns the intervention, or NULL if the ID does not exist.
+ * @note The pointer is only valid until the next insertion into the store.
+ */
+Intervention* findIntervention(InterventionStore* store, int id);
 
 /**
- * @brief Frees all memory allocated for the intervention list.
+ * @brief Frees all memory allocated for the intervention store.
  *
- * @param head Pointer to the head of the intervention linked list.
+ * @param store Pointer to the intervention store.
  */
-void freeInterventions(InterventionNode* head);
+void freeInterventions(InterventionStore* store);
 
-#endif // INTERVENTIONS_H
\ No newline at end of file
+#endif // INTERVENTIONS_H
@@ -0,0 +1,154 @@
+/**
+ * @file journal.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the append-only journal and its checkpoints.
+ */
+
+#include <stdio.h>   // Provides standard input and output functions (e.g., printf, scanf)
+#include <pthread.h> // Provides mutexes
+
+#include "journal.h"
+#include "symbols.h"
+#include "firefighters.h"
+#include "occurrences.h"
+#include "equipments.h"
+#include "interventions.h"
+
+static FILE* journalFile = NULL;
+static int pendingEntries = 0;
+static pthread_mutex_t journalLock = PTHREAD_MUTEX_INITIALIZER; // Writers of different stores may append at once (server mode)
+
+/**
+ * @brief Replays the journal over the stores loaded from the base files.
+ */
+int journalReplay(FirefighterStore* firefighters, int* idFirefighter,
+                  OccurrenceStore* occurrences, int* idOccurrence,
+                  EquipmentStore* equipments, int* idEquipment,
+                  InterventionStore* interventions, int* idIntervention) {
+    FILE* fp = fopen(FILE_JOURNAL, "rb");
+    JournalEntryHeader header;
+    union {
+        Firefighter firefighter;
+        Occurrence occurrence;
+        Equipment equipment;
+        Intervention intervention;
+        char text[MAX_STRING];
+    } record;
+    int applied = 0;
+
+    if (!fp) return 0;
+
+    while (fread(&header, sizeof(header), 1, fp) == 1) {
+        if (header.size <= 0 || header.size > (int) sizeof(record)) break;
+        if (fread(&record, header.size, 1, fp) != 1) break;
+
+        switch (header.kind) {
+            case JOURNAL_FIREFIGHTER:
+                upsertFirefighter(firefighters, &record.firefighter);
+                if (record.firefighter.id > *idFirefighter) *idFirefighter = record.firefighter.id;
+            break;
+            case JOURNAL_OCCURRENCE:
+                upsertOccurrence(occurrences, &record.occurrence);
+                if (record.occurrence.id > *idOccurrence) *idOccurrence = record.occurrence.id;
+            break;
+            case JOURNAL_EQUIPMENT:
+                upsertEquipment(equipments, &record.equipment);
+                if (record.equipment.id > *idEquipment) *idEquipment = record.equipment.id;
+            break;
+            case JOURNAL_INTERVENTION:
+                upsertIntervention(interventions, &record.intervention);
+                if (record.intervention.id > *idIntervention) *idIntervention = record.intervention.id;
+            break;
+            case JOURNAL_SYMBOL:
+                record.text[header.size - 1] = '\0';
+                internString(record.text);
+            break;
+        }
+        applied++;
+    }
+    fclose(fp);
+
+    pendingEntries = applied;
+    return applied;
+}
+
+/**
+ * @brief Opens the journal for appending.
+ */
+int journalOpen(void) {
+    if (journalFile) return 1;
+    journalFile = fopen(FILE_JOURNAL, "ab");
+    return journalFile != NULL;
+}
+
+/**
+ * @brief Appends the new version of a record to the journal and flushes it.
+ */
+void journalAppend(JournalKind kind, const void* record, int size) {
+    JournalEntryHeader header;
+    header.kind = kind;
+    header.size = size;
+
+    pthread_mutex_lock(&journalLock);
+    if (journalFile) {
+        fwrite(&header, sizeof(header), 1, journalFile);
+        fwrite(record, size, 1, journalFile);
+        // Hand the entry to the operating system now, so it survives a crash of the program.
+        fflush(journalFile);
+        pendingEntries++;
+    }
+    pthread_mutex_unlock(&journalLock);
+}
+
+/**
+ * @brief Returns the number of entries written since the last checkpoint.
+ */
+int journalPending(void) {
+    int pending;
+    pthread_mutex_lock(&journalLock);
+    pending = pendingEntries;
+    pthread_mutex_unlock(&journalLock);
+    return pending;
+}
+
+/**
+ * @brief Folds the journal into the base .bin files and empties it.
+ */
+int journalCheckpoint(FirefighterStore* firefighters, OccurrenceStore* occurrences,
+                      EquipmentStore* equipments, InterventionStore* interventions) {
+    int ok = 1;
+
+    // Symbols first: the records written next may reference new ones.
+    ok &= saveSymbols();
+    ok &= saveFirefighters(firefighters);
+    ok &= saveOccurrences(occurrences);
+    ok &= saveEquipments(equipments);
+    ok &= saveInterventions(interventions);
+    if (!ok) return 0;
+
+    // Every change is now in the base files: start an empty journal.
+    pthread_mutex_lock(&journalLock);
+    if (journalFile) {
+        fclose(journalFile);
+        journalFile = fopen(FILE_JOURNAL, "wb");
+    } else {
+        FILE* fp = fopen(FILE_JOURNAL, "wb");
+        if (fp) fclose(fp);
+    }
+    pendingEntries = 0;
+    pthread_mutex_unlock(&journalLock);
+    return 1;
+}
+
+/**
+ * @brief Closes the journal file.
+ */
+void journalClose(void) {
+    if (journalFile) fclose(journalFile);
+    journalFile = NULL;
+}
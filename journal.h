@@ -0,0 +1,107 @@
+/**
+ * @file journal.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the append-only journal (write-ahead log) that persists every change immediately.
+ *
+ * Each create, update or soft delete appends the full new version of the record to the journal.
+ * On startup the journal is replayed over the base .bin files, and a checkpoint folds it back
+ * into them, so the cost of each save is proportional to the change and not to the dataset.
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "data.h"
+
+/**
+ * @brief Number of journal entries after which the main loop performs a checkpoint.
+ */
+#define JOURNAL_CHECKPOINT_ENTRIES 1000
+
+/**
+ * @brief Identifies the entity type of a journal entry.
+ */
+typedef enum {
+    JOURNAL_FIREFIGHTER,
+    JOURNAL_OCCURRENCE,
+    JOURNAL_EQUIPMENT,
+    JOURNAL_INTERVENTION,
+    JOURNAL_SYMBOL
+} JournalKind;
+
+/**
+ * @brief Header written before each record in the journal file.
+ */
+typedef struct {
+    int kind;
+    int size;
+} JournalEntryHeader;
+
+/**
+ * @brief Replays the journal over the stores loaded from the base files.
+ *
+ * Record entries are applied as upserts by ID and symbol entries are interned again in the same
+ * order (so they get the same symbols); a truncated entry at the end (e.g. after a crash) is ignored.
+ *
+ * @param firefighters Pointer to the firefighter store.
+ * @param idFirefighter Pointer to the firefighter ID sequence counter.
+ * @param occurrences Pointer to the occurrence store.
+ * @param idOccurrence Pointer to the occurrence ID sequence counter.
+ * @param equipments Pointer to the equipment store.
+ * @param idEquipment Pointer to the equipment ID sequence counter.
+ * @param interventions Pointer to the intervention store.
+ * @param idIntervention Pointer to the intervention ID sequence counter.
+ * @return Returns the number of entries applied.
+ */
+int journalReplay(FirefighterStore* firefighters, int* idFirefighter,
+                  OccurrenceStore* occurrences, int* idOccurrence,
+                  EquipmentStore* equipments, int* idEquipment,
+                  InterventionStore* interventions, int* idIntervention);
+
+/**
+ * @brief Opens the journal for appending. Until it is opened, journalAppend does nothing.
+ *
+ * @return Returns 1 on success, 0 if the journal file could not be opened.
+ */
+int journalOpen(void);
+
+/**
+ * @brief Appends the new version of a record to the journal and flushes it.
+ *
+ * @param kind Entity type of the record.
+ * @param record Pointer to the record.
+ * @param size Size of the record in bytes.
+ */
+void journalAppend(JournalKind kind, const void* record, int size);
+
+/**
+ * @brief Returns the number of entries written since the last checkpoint.
+ */
+int journalPending(void);
+
+/**
+ * @brief Folds the journal into the base .bin files and empties it.
+ *
+ * Only the records and symbols created or changed since the last checkpoint are written to the
+ * base files. The journal is only truncated if every base file was written successfully.
+ *
+ * @param firefighters Pointer to the firefighter store.
+ * @param occurrences Pointer to the occurrence store.
+ * @param equipments Pointer to the equipment store.
+ * @param interventions Pointer to the intervention store.
+ * @return Returns 1 on success, 0 if any base file could not be written.
+ */
+int journalCheckpoint(FirefighterStore* firefighters, OccurrenceStore* occurrences,
+                      EquipmentStore* equipments, InterventionStore* interventions);
+
+/**
+ * @brief Closes the journal file.
+ */
+void journalClose(void);
+
+#endif // JOURNAL_H
@@ -21,17 +21,48 @@
  * @date 2025-2026
  */
 
-#include <stdio.h> // Provides standard input and output functions (e.g., printf, scanf)
+#include <stdio.h>  // Provides standard input and output functions (e.g., printf, scanf)
+#include <string.h> // Provides functions for string manipulation (e.g., strcmp)
 
 #include "firefighters.h"
 #include "occurrences.h"
 #include "equipments.h"
 #include "interventions.h"
 #include "statistics.h"
+#include "journal.h"
+#include "symbols.h"
+#include "datetime.h"
+#include "parallel.h"
+#include "batch.h"
+#include "server.h"
+#include "tail.h"
+#include "import.h"
 
 #include "input.h"
 #include "data.h"
 
+/**
+ * @brief Folds the journal into the base files and frees every store.
+ *
+ * @return Returns 1 if the base files were written, 0 otherwise (the journal is then kept).
+ */
+static int closeStores(FirefighterStore* firefighters, OccurrenceStore* occurrences,
+                       EquipmentStore* equipments, InterventionStore* interventions) {
+    // Fold the journal into the base files; the rollup cube is only kept if they were written.
+    int saved = journalCheckpoint(firefighters, occurrences, equipments, interventions);
+    if (saved) saveOccurrenceRollup(occurrences);
+    journalClose();
+
+    // Critical step to prevent memory leaks in the operating system.
+    freeFirefighters(firefighters);
+    freeOccurrences(occurrences);
+    freeEquipments(equipments);
+    freeInterventions(interventions);
+    freeSymbols();
+    parallelShutdown();
+    return saved;
+}
+
 /**
  * @brief Entry point of the Firefighter Management System.
  *
@@ -43,23 +74,86 @@
  * - Occurrences/Incidents Management (Create, List, Update, Delete)
  * - Equipments Management (Create, List, Update, Delete)
  *
+ * With "--batch FILE" (or "--batch -" for stdin) no menu is shown: the commands of the file are
+ * applied (see batch.h), the data is saved and the program exits. With "--server SOCKET" the
+ * stores are served to local clients (see server.h) until SIGINT or SIGTERM. With "--tail FILE"
+ * the occurrence reports appended to a log file or named pipe are added as they arrive (see tail.h).
+ * "--import-occurrences FILE" and "--import-interventions FILE" load historical records in bulk
+ * from CSV or NDJSON (see import.h).
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
  * @return Returns 0 upon successful program termination.
  */
-int main() {
-    // Initialize all linked list pointers to NULL
-    FirefighterNode* listFirefighters = NULL;
-    OccurrenceNode* listOccurrences = NULL;
-    EquipmentNode* listEquipments = NULL;
-    InterventionNode* listInterventions = NULL;
+int main(int argc, char* argv[]) {
+    // Contiguous stores for every entity (filled by the load functions)
+    FirefighterStore firefighters;
+    OccurrenceStore occurrences;
+    EquipmentStore equipments;
+    InterventionStore interventions;
 
     // Initialize ID counters
     int idFirefighter = 0, idOccurrence = 0, idEquipment = 0, idIntervention = 0;
 
     // Loading binary files ensures data persistence between sessions.
-    listFirefighters = loadFirefighters(&idFirefighter);
-    listOccurrences = loadOccurrences(&idOccurrence);
-    listEquipments = loadEquipments(&idEquipment);
-    listInterventions = loadInterventions(&idIntervention);
+    loadSymbols();
+    loadFirefighters(&firefighters, &idFirefighter);
+    loadOccurrences(&occurrences, &idOccurrence);
+    loadEquipments(&equipments, &idEquipment);
+    loadInterventions(&interventions, &occurrences, &idIntervention);
+
+    // Changes journaled after the last checkpoint (e.g. before a crash) are applied on top.
+    journalReplay(&firefighters, &idFirefighter, &occurrences, &idOccurrence,
+                  &equipments, &idEquipment, &interventions, &idIntervention);
+    journalOpen();
+
+    if (argc == 3 && strcmp(argv[1], "--batch") == 0) {
+        FILE* input = strcmp(argv[2], "-") == 0 ? stdin : fopen(argv[2], "r");
+        int rejected = -1;
+        if (input) {
+            rejected = runBatch(input, &firefighters, &idFirefighter, &occurrences, &idOccurrence,
+                                &equipments, &idEquipment, &interventions, &idIntervention);
+            if (input != stdin) fclose(input);
+        } else {
+            fprintf(stderr, "Não foi possível abrir %s.\n", argv[2]);
+        }
+
+        closeStores(&firefighters, &occurrences, &equipments, &interventions);
+        return rejected == 0 ? 0 : 1;
+    }
+
+    if (argc == 3 && strcmp(argv[1], "--server") == 0) {
+        int served = runServer(argv[2], &firefighters, &idFirefighter, &occurrences, &idOccurrence,
+                               &equipments, &idEquipment, &interventions, &idIntervention);
+        if (!served) fprintf(stderr, "Não foi possível abrir o socket %s.\n", argv[2]);
+        closeStores(&firefighters, &occurrences, &equipments, &interventions);
+        return served ? 0 : 1;
+    }
+
+    if (argc == 3 && strcmp(argv[1], "--tail") == 0) {
+        int followed = runTail(argv[2], &firefighters, &occurrences, &idOccurrence, &equipments, &interventions);
+        if (!followed) fprintf(stderr, "Não foi possível abrir %s.\n", argv[2]);
+        closeStores(&firefighters, &occurrences, &equipments, &interventions);
+        return followed ? 0 : 1;
+    }
+
+    if (argc == 3 && (strcmp(argv[1], "--import-occurrences") == 0 || strcmp(argv[1], "--import-interventions") == 0)) {
+        ImportResult result;
+        int read = strcmp(argv[1], "--import-occurrences") == 0
+                       ? importOccurrences(argv[2], &occurrences, &idOccurrence, &result)
+                       : importInterventions(argv[2], &interventions, &occurrences, &firefighters, &equipments,
+                                             &idIntervention, &result);
+        if (!read) fprintf(stderr, "Não foi possível importar %s.\n", argv[2]);
+        // Rows added before a failure stay in the store, so their IDs are reported too.
+        if (read || result.imported > 0) printImportResult(&result);
+
+        // Imported rows are not journaled: they only reach disk through this checkpoint.
+        if (!closeStores(&firefighters, &occurrences, &equipments, &interventions)) {
+            fprintf(stderr, "Não foi possível gravar os registos importados.\n");
+            return 1;
+        }
+        return read && result.rejected == 0 ? 0 : 1;
+    }
 
     // Welcome messages
     printf("Bem-vindo ao projeto Gestão de incêndios!\n");
@@ -80,44 +174,54 @@ int main() {
 
         switch (option) {
             case 1:
-                menuFirefighters(&listFirefighters, &idFirefighter);
+                menuFirefighters(&firefighters, &idFirefighter);
             break;
             case 2:
-                menuOccurrences(&listOccurrences, &idOccurrence);
+                menuOccurrences(&occurrences, &idOccurrence);
             break;
             case 3:
-                menuEquipments(&listEquipments, &idEquipment);
+                menuEquipments(&equipments, &idEquipment);
             break;
             case 4:
-                menuInterventions(&listInterventions, listOccurrences, listFirefighters, listEquipments, &idIntervention);
+                menuInterventions(&interventions, &occurrences, &firefighters, &equipments, &idIntervention);
             break;
             case 5:
                 printf("\n--- ESTATÍSTICAS E ESTRATÉGIA ---\n");
                 printf("1. Monitor de Capacidade Operacional\n");
                 printf("2. Relatório de Eficiência Operacional (Tempo/Tipo)\n");
                 printf("3. Análise de Desgaste de Equipamento (Manutenção)\n");
+                printf("4. Relatório de Ocorrências por Período\n");
+                printf("5. Recomendar Meios para Ocorrência\n");
+                printf("6. Tendência Mensal de Ocorrências\n");
                 printf("0. Voltar\n");
 
-                int subOp = getInt(0, 3, "Opção: ");
+                int subOp = getInt(0, 6, "Opção: ");
 
-                if (subOp == 1) showOperationalMonitor(listFirefighters, listEquipments);
-                if (subOp == 2) reportOperationalEfficiency(listOccurrences);
-                if (subOp == 3) reportEquipmentStrain(listEquipments);
+                if (subOp == 1) showOperationalMonitor(&firefighters, &equipments, &occurrences);
+                if (subOp == 2) reportOperationalEfficiency(&occurrences);
+                if (subOp == 3) reportEquipmentStrain(&equipments);
+                if (subOp == 4) {
+                    printf("Data inicial:\n");
+                    Timestamp from = readDateTime();
+                    printf("Data final:\n");
+                    Timestamp to = readDateTime();
+                    reportOccurrencesInRange(&occurrences, from, to);
+                }
+                if (subOp == 5) {
+                    int occurrenceId = getInt(1, MAX_ID, "ID da Ocorrência: ");
+                    showRecommendation(&firefighters, &equipments, &occurrences, occurrenceId);
+                }
+                if (subOp == 6) reportMonthlyTrend(&occurrences, getInt(2020, 2030, "Ano: "));
             break;
             case 0:
-                // Save information
-                saveFirefighters(listFirefighters);
-                saveOccurrences(listOccurrences);
-                saveEquipments(listEquipments);
-                saveInterventions(listInterventions);
-
-                // Critical step to prevent memory leaks in the operating system.
-                freeFirefighters(listFirefighters);
-                freeOccurrences(listOccurrences);
-                freeEquipments(listEquipments);
-                freeInterventions(listInterventions);
+                closeStores(&firefighters, &occurrences, &equipments, &interventions);
             break;
         }
+
+        // Every change is already journaled; fold it into the base files from time to time.
+        if (option != 0 && journalPending() >= JOURNAL_CHECKPOINT_ENTRIES) {
+            journalCheckpoint(&firefighters, &occurrences, &equipments, &interventions);
+        }
     } while (option != 0);
 
     return 0;
@@ -11,214 +11,732 @@
 
 #include <stdio.h>   // Provides standard input and output functions (e.g., printf, scanf)
 #include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
-#include <string.h> // Provides functions for string manipulation (e.g., strcpy, strlen)
+#include <string.h>  // Provides functions for string manipulation (e.g., memmove)
+#include <ctype.h>   // Provides character classification functions (e.g., tolower)
 
 #include "occurrences.h"
+#include "aggregate.h"
+#include "parallel.h"
+#include "column.h"
+#include "datetime.h"
+#include "store.h"
+#include "journal.h"
+#include "symbols.h"
 #include "input.h"
 
-/**
- * @brief Helper function to read date and time from user input.
- *
- * @return Returns the populated DateTime structure.
- */
-DateTime readDateTime() {
-    DateTime dt;
-    printf("--- Data e Hora ---\n");
-    dt.day = getInt(1, 31, "Dia: ");
-    dt.month = getInt(1, 12, "Mês: ");
-    dt.year = getInt(2020, 2030, "Ano: ");
-    dt.hour = getInt(0, 23, "Hora: ");
-    dt.minute = getInt(0, 59, "Minuto: ");
-    return dt;
-}
+#define OCCURRENCES_MAGIC 0x5243434F // "OCCR"
+#define OCCURRENCES_VERSION 1
+
+static const char* TYPE_NAMES[] = { "Florestal", "Urbano", "Industrial" };
+static const char* PRIORITY_NAMES[] = { "Baixa", "Normal", "Alta" };
+
+// Lowercase keywords that tie a specialty or an equipment type to each occurrence type.
+static const char* TYPE_KEYWORDS[][4] = {
+    { "florest", "forest", "rural", NULL },
+    { "urban", "edif", "resgate", NULL },
+    { "indust", "quimic", "químic", NULL }
+};
 
 /**
  * @brief Displays the Occurrence management menu.
  */
-void menuOccurrences(OccurrenceNode** head, int* idSeq) {
+void menuOccurrences(OccurrenceStore* store, int* idSeq) {
     int op;
     do {
         printf("\n--- GESTÃO DE OCORRÊNCIAS ---\n");
         printf("1. Registar Ocorrência\n2. Listar Ocorrências\n3. Atualizar Estado\n4. Cancelar Ocorrência\n");
-        printf("5. Estatísticas por Localização (Relatório)\n0. Voltar\n");
-        op = getInt(0, 5, "Opção: ");
+        printf("5. Estatísticas por Localização (Relatório)\n6. Listar por Intervalo de Datas\n");
+        printf("7. Próximas a Despachar\n8. Alterar Prioridade\n9. Filtrar por Estado e Tipo\n0. Voltar\n");
+        op = getInt(0, 9, "Opção: ");
         switch (op) {
             case 1:
-                *head = createOccurrence(*head, idSeq);
+                createOccurrence(store, idSeq);
             break;
             case 2:
-                listOccurrences(*head);
+                listOccurrences(store);
             break;
             case 3:
-                updateOccurrence(*head);
+                updateOccurrence(store);
             break;
             case 4:
-                *head = deleteOccurrence(*head);
+                deleteOccurrence(store);
             break;
-            case 5:
-                listOccurrenceStats(*head);
+            case 5: {
+                int groupBy = 0;
+                if (getInt(0, 1, "Agrupar também por tipo? (0-Não, 1-Sim): ")) groupBy |= GROUP_BY_TYPE;
+                if (getInt(0, 1, "Agrupar também por prioridade? (0-Não, 1-Sim): ")) groupBy |= GROUP_BY_PRIORITY;
+                int topN = getInt(0, 99999, "Mostrar os N mais frequentes (0 = todos): ");
+                listOccurrenceStats(store, groupBy, topN);
+            }
+            break;
+            case 6: {
+                printf("Data inicial:\n");
+                Timestamp from = readDateTime();
+                printf("Data final:\n");
+                Timestamp to = readDateTime();
+                listOccurrencesInRange(store, from, to);
+            }
+            break;
+            case 7:
+                listDispatchQueue(store, 5);
+            break;
+            case 8:
+                updateOccurrencePriority(store);
+            break;
+            case 9: {
+                int status = getInt(0, 3, "Estado (0-Reportada, 1-Em Curso, 2-Resolvida, 3-Todos): ");
+                int type = getInt(0, 3, "Tipo (0-Florestal, 1-Urbano, 2-Industrial, 3-Todos): ");
+                listOccurrencesMatching(store, status == 3 ? -1 : status, type == 3 ? -1 : type);
+            }
             break;
         }
     } while (op != 0);
 }
 
 /**
- * @brief Creates a new occurrence.
+ * @brief Tells whether the occurrence in slot a comes before the one in slot b (timestamp, then ID).
+ */
+static int comesBefore(const Occurrence* items, int a, int b) {
+    if (items[a].timestamp != items[b].timestamp) return items[a].timestamp < items[b].timestamp;
+    return items[a].id < items[b].id;
+}
+
+/**
+ * @brief First position of the time index whose timestamp is not before t.
+ */
+static int lowerBound(const OccurrenceStore* store, Timestamp t) {
+    int low = 0, high = store->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (store->items[store->byTime[mid]].timestamp < t) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief First position of the time index whose timestamp is after t.
+ */
+static int upperBound(const OccurrenceStore* store, Timestamp t) {
+    int low = 0, high = store->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (store->items[store->byTime[mid]].timestamp <= t) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief Adds the occurrence in a slot to the time index (the slot must already be counted).
+ *
+ * New occurrences are usually the most recent ones, in which case this is an append.
+ */
+static void timeIndexInsert(OccurrenceStore* store, int slot) {
+    int pos = store->count - 1;
+    int low = 0, high = pos;
+    if (pos > 0 && comesBefore(store->items, slot, store->byTime[pos - 1])) {
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (comesBefore(store->items, store->byTime[mid], slot)) low = mid + 1;
+            else high = mid;
+        }
+        pos = low;
+        memmove(&store->byTime[pos + 1], &store->byTime[pos], sizeof(int) * (store->count - 1 - pos));
+    }
+    store->byTime[pos] = slot;
+}
+
+/**
+ * @brief Removes the occurrence in a slot from the time index (before its timestamp changes).
+ */
+static void timeIndexRemove(OccurrenceStore* store, int slot) {
+    int pos = lowerBound(store, store->items[slot].timestamp);
+    while (pos < store->count && store->byTime[pos] != slot) pos++;
+    if (pos == store->count) return;
+    memmove(&store->byTime[pos], &store->byTime[pos + 1], sizeof(int) * (store->count - 1 - pos));
+}
+
+/**
+ * @brief Items being sorted by buildTimeIndex (qsort has no context argument).
+ */
+static const Occurrence* sortingItems;
+
+static int compareByTime(const void* a, const void* b) {
+    int sa = *(const int*) a, sb = *(const int*) b;
+    if (comesBefore(sortingItems, sa, sb)) return -1;
+    return comesBefore(sortingItems, sb, sa) ? 1 : 0;
+}
+
+/**
+ * @brief Builds the time index of every occurrence in the store.
+ */
+static void buildTimeIndex(OccurrenceStore* store) {
+    int i;
+    if (!storeReserve((void**) &store->byTime, &store->byTimeCapacity, NULL, store->count, sizeof(int))) return;
+    for (i = 0; i < store->count; i++) store->byTime[i] = i;
+    sortingItems = store->items;
+    if (store->count > 1) qsort(store->byTime, store->count, sizeof(int), compareByTime);
+}
+
+/**
+ * @brief Heap order of the dispatch queue: higher priority first, then older, then lower ID.
+ */
+static int moreUrgent(const void* context, int a, int b) {
+    const Occurrence* items = ((const OccurrenceStore*) context)->items;
+    if (items[a].priority != items[b].priority) return items[a].priority > items[b].priority;
+    if (items[a].timestamp != items[b].timestamp) return items[a].timestamp < items[b].timestamp;
+    return items[a].id < items[b].id;
+}
+
+/**
+ * @brief Puts an occurrence in (or takes it out of) the dispatch queue after a change.
+ */
+static void trackDispatch(OccurrenceStore* store, int slot) {
+    if (store->items[slot].status == REPORTED) heapPush(&store->dispatch, slot);
+    else heapRemove(&store->dispatch, slot);
+}
+
+/**
+ * @brief Updates the resolution-time histograms after a change to an occurrence.
+ */
+static void trackResolution(OccurrenceStore* store, int slot) {
+    const Occurrence* record = &store->items[slot];
+    if (record->status == RESOLVED && record->endedAt != NO_TIMESTAMP) {
+        histogramGridTrack(&store->resolutionTimes, slot, TYPE_PRIORITY_CELL(record->type, record->priority),
+                           record->endedAt - record->timestamp);
+    } else {
+        histogramGridTrack(&store->resolutionTimes, slot, -1, 0);
+    }
+}
+
+/**
+ * @brief Copies the status, type and priority of an occurrence into the columns after a change.
+ */
+static void trackColumns(OccurrenceStore* store, int slot) {
+    const Occurrence* record = &store->items[slot];
+    columnSet(&store->statusColumn, slot, (unsigned char) record->status);
+    columnSet(&store->typeColumn, slot, (unsigned char) record->type);
+    columnSet(&store->priorityColumn, slot, (unsigned char) record->priority);
+}
+
+/**
+ * @brief Updates the rollup cube after a change to an occurrence.
  */
-OccurrenceNode* createOccurrence(OccurrenceNode* head, int* idSeq) {
-    OccurrenceNode* newNode = (OccurrenceNode*) malloc(sizeof(OccurrenceNode));
-    if (!newNode) return head;
+static void trackRollup(OccurrenceStore* store, int slot, int attachOnly) {
+    const Occurrence* record = &store->items[slot];
+    RollupSample sample;
+
+    sample.timestamp = record->timestamp;
+    sample.type = record->status == OCCURRENCE_INACTIVE ? -1 : (int) record->type;
+    sample.priority = record->priority;
+    sample.location = record->location;
+    sample.duration = record->status == RESOLVED && record->endedAt != NO_TIMESTAMP && record->endedAt >= record->timestamp
+                          ? record->endedAt - record->timestamp : -1;
+    if (attachOnly) rollupAttach(&store->rollup, slot, &sample);
+    else rollupTrack(&store->rollup, slot, &sample);
+}
+
+/**
+ * @brief Appends an occurrence record to the store and indexes it by ID and time.
+ */
+Occurrence* insertOccurrence(OccurrenceStore* store, const Occurrence* record) {
+    if (!storeReserve((void**) &store->items, &store->capacity, &store->mappedSize, store->count + 1, sizeof(Occurrence))) return NULL;
+    if (!storeReserve((void**) &store->byTime, &store->byTimeCapacity, NULL, store->count + 1, sizeof(int))) return NULL;
+    if (!idIndexPut(&store->index, record->id, store->count)) return NULL;
+    store->items[store->count] = *record;
+    store->count++;
+    timeIndexInsert(store, store->count - 1);
+    trackDispatch(store, store->count - 1);
+    trackResolution(store, store->count - 1);
+    trackColumns(store, store->count - 1);
+    trackRollup(store, store->count - 1, 0);
+    return &store->items[store->count - 1];
+}
+
+/**
+ * @brief Appends many occurrence records, sorting the time index once if they arrive out of order.
+ */
+int appendOccurrences(OccurrenceStore* store, const Occurrence* records, int count) {
+    int i, sorted = 1;
+
+    if (!storeReserve((void**) &store->items, &store->capacity, &store->mappedSize, store->count + count, sizeof(Occurrence))) return 0;
+    if (!storeReserve((void**) &store->byTime, &store->byTimeCapacity, NULL, store->count + count, sizeof(int))) return 0;
+    for (i = 0; i < count; i++) {
+        int slot = store->count;
+        if (!idIndexPut(&store->index, records[i].id, slot)) return 0;
+        store->items[slot] = records[i];
+        store->byTime[slot] = slot;
+        if (slot > 0 && comesBefore(store->items, slot, store->byTime[slot - 1])) sorted = 0;
+        store->count++;
+        trackDispatch(store, slot);
+        trackResolution(store, slot);
+        trackColumns(store, slot);
+        trackRollup(store, slot, 0);
+    }
+    if (!sorted) buildTimeIndex(store);
+    return 1;
+}
 
+/**
+ * @brief Replaces the occurrence with the same ID or appends it.
+ */
+Occurrence* upsertOccurrence(OccurrenceStore* store, const Occurrence* record) {
+    Occurrence* existing = findOccurrence(store, record->id);
+    if (!existing) return insertOccurrence(store, record);
+
+    if (existing->timestamp != record->timestamp) {
+        int slot = (int) (existing - store->items);
+        timeIndexRemove(store, slot);
+        *existing = *record;
+        timeIndexInsert(store, slot);
+    }
+    *existing = *record;
+    trackDispatch(store, (int) (existing - store->items));
+    trackResolution(store, (int) (existing - store->items));
+    trackColumns(store, (int) (existing - store->items));
+    trackRollup(store, (int) (existing - store->items), 0);
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (existing - store->items));
+    return existing;
+}
+
+/**
+ * @brief Finds an occurrence by ID in constant time.
+ */
+Occurrence* findOccurrence(OccurrenceStore* store, int id) {
+    int slot = idIndexGet(&store->index, id);
+    return slot < 0 ? NULL : &store->items[slot];
+}
+
+/**
+ * @brief Flags a modified occurrence for the next save and journals it.
+ */
+void touchOccurrence(OccurrenceStore* store, const Occurrence* record) {
+    trackDispatch(store, (int) (record - store->items));
+    trackResolution(store, (int) (record - store->items));
+    trackColumns(store, (int) (record - store->items));
+    trackRollup(store, (int) (record - store->items), 0);
+    storeMarkDirty(store->dirty, store->persistedCount, (int) (record - store->items));
+    journalAppend(JOURNAL_OCCURRENCE, record, sizeof(Occurrence));
+}
+
+/**
+ * @brief Registers a REPORTED occurrence from its fields (no user interaction).
+ */
+Occurrence* addOccurrence(OccurrenceStore* store, int* idSeq, Symbol location, OccurrenceType type,
+                          Priority priority, Timestamp timestamp) {
+    Occurrence temp;
+    Occurrence* created;
+
+    temp.id = *idSeq + 1;
+    temp.location = location;
+    temp.type = type;
+    temp.priority = priority;
+    temp.timestamp = timestamp;
+    temp.status = REPORTED;
+    temp.endedAt = NO_TIMESTAMP;
+
+    created = insertOccurrence(store, &temp);
+    if (!created) return NULL;
     (*idSeq)++;
-    newNode->data.id = *idSeq;
+    touchOccurrence(store, created);
+    return created;
+}
+
+/**
+ * @brief Creates a new occurrence.
+ */
+Occurrence* createOccurrence(OccurrenceStore* store, int* idSeq) {
+    Occurrence* created;
+    OccurrenceType type;
+    Priority priority;
+    char location[MAX_STRING];
 
     cleanInputBuffer();
-    getString(newNode->data.location, MAX_STRING, "Localização: ");
+    getString(location, MAX_STRING, "Localização: ");
 
     printf("Tipo (0-Florestal, 1-Urbano, 2-Industrial)\n");
-    newNode->data.type = (OccurrenceType) getInt(0, 2, "Tipo: ");
+    type = (OccurrenceType) getInt(0, 2, "Tipo: ");
 
     printf("Prioridade (0-Baixa, 1-Normal, 2-Alta)\n");
-    newNode->data.priority = (Priority) getInt(0, 2, "Prioridade: ");
-
-    newNode->data.timestamp = readDateTime();
-    newNode->data.status = REPORTED;
+    priority = (Priority) getInt(0, 2, "Prioridade: ");
 
-    newNode->data.endedAt.year = 0;
+    created = addOccurrence(store, idSeq, internString(location), type, priority, readDateTime());
+    if (!created) return NULL;
 
-    newNode->next = head;
     printf("Ocorrência registada com ID %d.\n", *idSeq);
-    return newNode;
+    return created;
 }
 
 /**
  * @brief Lists all occurrences.
  */
-void listOccurrences(OccurrenceNode* head) {
-    if(!head) { printf("Sem ocorrências registadas.\n"); return; }
+void listOccurrences(const OccurrenceStore* store) {
+    int i;
+    if(store->count == 0) { printf("Sem ocorrências registadas.\n"); return; }
     printf("\n%-5s | %-20s | %-10s | %-10s\n", "ID", "LOCAL", "PRIORIDADE", "ESTADO");
-    OccurrenceNode* current = head;
-    while (current) {
-        if (current->data.status != OCCURRENCE_INACTIVE) {
+    for (i = 0; i < store->count; i++) {
+        const Occurrence* current = &store->items[i];
+        if (current->status != OCCURRENCE_INACTIVE) {
             printf("%-5d | %-20s | %-10d | %-10d\n",
-                current->data.id, current->data.location, current->data.priority, current->data.status);
+                current->id, symbolText(current->location), current->priority, current->status);
         }
-        current = current->next;
     }
 }
 
+/**
+ * @brief Builds the column conditions of a query (-1 leaves a field unconstrained).
+ */
+static int buildKeys(const OccurrenceStore* store, int status, int type, int priority, ColumnKey* keys) {
+    int n = 0;
+    if (status >= 0) { keys[n].column = &store->statusColumn; keys[n++].value = (unsigned char) status; }
+    if (type >= 0) { keys[n].column = &store->typeColumn; keys[n++].value = (unsigned char) type; }
+    if (priority >= 0) { keys[n].column = &store->priorityColumn; keys[n++].value = (unsigned char) priority; }
+    return n;
+}
+
+/**
+ * @brief Counts the occurrences with a status, type and priority.
+ */
+int countOccurrences(const OccurrenceStore* store, int status, int type, int priority) {
+    ColumnKey keys[3];
+    int n = buildKeys(store, status, type, priority, keys);
+    return columnCount(keys, n, store->count);
+}
+
+/**
+ * @brief Lists the occurrences with a status and type.
+ */
+void listOccurrencesMatching(const OccurrenceStore* store, int status, int type) {
+    ColumnKey keys[3];
+    int n = buildKeys(store, status, type, -1, keys);
+    int* slots;
+    int found, listed = 0, i;
+
+    if (store->count == 0) { printf("Sem ocorrências registadas.\n"); return; }
+    slots = (int*) malloc(sizeof(int) * store->count);
+    if (!slots) { printf("Erro: Memória insuficiente.\n"); return; }
+    found = columnFilter(keys, n, store->count, store->count, slots);
+
+    printf("\n%-5s | %-20s | %-10s | %-10s | %-10s\n", "ID", "LOCAL", "TIPO", "PRIORIDADE", "ESTADO");
+    for (i = 0; i < found; i++) {
+        const Occurrence* current = &store->items[slots[i]];
+        if (current->status == OCCURRENCE_INACTIVE) continue;
+        listed++;
+        printf("%-5d | %-20s | %-10s | %-10s | %-10d\n", current->id, symbolText(current->location),
+               TYPE_NAMES[current->type], PRIORITY_NAMES[current->priority], current->status);
+    }
+    printf("%d ocorrência(s).\n", listed);
+    free(slots);
+}
+
+/**
+ * @brief Returns the next occurrence to dispatch.
+ */
+Occurrence* nextToDispatch(OccurrenceStore* store) {
+    int slot = heapPeek(&store->dispatch);
+    return slot < 0 ? NULL : &store->items[slot];
+}
+
+/**
+ * @brief Lists the first occurrences of the dispatch queue, in dispatch order.
+ */
+void listDispatchQueue(const OccurrenceStore* store, int limit) {
+    int slots[16];
+    int n, i;
+
+    if (store->dispatch.count == 0) { printf("Sem ocorrências por despachar.\n"); return; }
+    if (limit > 16) limit = 16;
+    n = heapFirst(&store->dispatch, limit, slots);
+
+    printf("\n=== FILA DE DESPACHO (%d pendente(s)) ===\n", store->dispatch.count);
+    for (i = 0; i < n; i++) {
+        const Occurrence* current = &store->items[slots[i]];
+        char when[TIMESTAMP_TEXT];
+        formatTimestamp(current->timestamp, when);
+        printf("%s%d. [%d] %s - %s, prioridade %s, desde %s\n", i == 0 ? ">> " : "   ", i + 1, current->id,
+               symbolText(current->location), TYPE_NAMES[current->type], PRIORITY_NAMES[current->priority], when);
+    }
+}
+
+/**
+ * @brief Changes the priority of an occurrence, repositioning it in the dispatch queue.
+ */
+void updateOccurrencePriority(OccurrenceStore* store) {
+    int id = getInt(1, MAX_ID, "ID da Ocorrência: ");
+    Occurrence* current = findOccurrence(store, id);
+    if (current && current->status != OCCURRENCE_INACTIVE) {
+        changeOccurrencePriority(store, id, (Priority) getInt(0, 2, "Nova Prioridade (0-Baixa, 1-Normal, 2-Alta): "));
+        printf("Prioridade atualizada.\n");
+        return;
+    }
+    printf("Ocorrência não encontrada.\n");
+}
+
+/**
+ * @brief Changes the priority of an active occurrence by ID (no user interaction).
+ */
+int changeOccurrencePriority(OccurrenceStore* store, int id, Priority priority) {
+    Occurrence* current = findOccurrence(store, id);
+    if (!current || current->status == OCCURRENCE_INACTIVE) return 0;
+    current->priority = priority;
+    touchOccurrence(store, current);
+    return 1;
+}
+
+/**
+ * @brief Finds the occurrences of a date range with two binary searches on the time index.
+ */
+int findOccurrencesInRange(const OccurrenceStore* store, Timestamp from, Timestamp to, int* first) {
+    *first = lowerBound(store, from);
+    if (to < from) return 0;
+    return upperBound(store, to) - *first;
+}
+
+/**
+ * @brief Lists the active occurrences of a date range in chronological order.
+ */
+void listOccurrencesInRange(const OccurrenceStore* store, Timestamp from, Timestamp to) {
+    int first, n, i, shown = 0;
+    char when[TIMESTAMP_TEXT];
+
+    if (to < from) { printf("Intervalo inválido.\n"); return; }
+    n = findOccurrencesInRange(store, from, to, &first);
+
+    printf("\n%-5s | %-16s | %-20s | %-10s | %-10s\n", "ID", "DATA", "LOCAL", "PRIORIDADE", "ESTADO");
+    for (i = first; i < first + n; i++) {
+        const Occurrence* current = &store->items[store->byTime[i]];
+        if (current->status == OCCURRENCE_INACTIVE) continue;
+        formatTimestamp(current->timestamp, when);
+        printf("%-5d | %-16s | %-20s | %-10d | %-10d\n",
+            current->id, when, symbolText(current->location), current->priority, current->status);
+        shown++;
+    }
+    if (shown == 0) printf("Sem ocorrências no intervalo indicado.\n");
+}
+
 /**
  * @brief Updates the status of an occurrence.
  */
-void updateOccurrence(OccurrenceNode* head) {
-    int id = getInt(1, 99999, "ID da Ocorrência: ");
-    OccurrenceNode* current = head;
-    while(current) {
-        if(current->data.id == id && current->data.status != OCCURRENCE_INACTIVE) {
-            printf("Novo Estado (0-Reportada, 1-Em Intervenção, 2-Concluída): ");
-            int st = getInt(0, 2, "Estado: ");
-            current->data.status = (OccurrenceStatus)st;
-
-            if (st == RESOLVED) {
-                printf("Inserir Data de Conclusão:\n");
-                current->data.endedAt = readDateTime();
-            }
+void updateOccurrence(OccurrenceStore* store) {
+    int id = getInt(1, MAX_ID, "ID da Ocorrência: ");
+    Occurrence* current = findOccurrence(store, id);
+    if(current && current->status != OCCURRENCE_INACTIVE) {
+        printf("Novo Estado (0-Reportada, 1-Em Intervenção, 2-Concluída): ");
+        int st = getInt(0, 2, "Estado: ");
+        Timestamp endedAt = current->endedAt;
 
-            printf("Estado atualizado.\n");
-            return;
+        if (st == RESOLVED) {
+            printf("Inserir Data de Conclusão:\n");
+            endedAt = readDateTime();
         }
-        current = current->next;
+        changeOccurrenceStatus(store, id, (OccurrenceStatus) st, endedAt);
+
+        printf("Estado atualizado.\n");
+        return;
     }
     printf("Ocorrência não encontrada.\n");
 }
 
+/**
+ * @brief Changes the status (and end date) of an active occurrence by ID (no user interaction).
+ */
+int changeOccurrenceStatus(OccurrenceStore* store, int id, OccurrenceStatus status, Timestamp endedAt) {
+    Occurrence* current = findOccurrence(store, id);
+    if (!current || current->status == OCCURRENCE_INACTIVE) return 0;
+    current->status = status;
+    current->endedAt = endedAt;
+    touchOccurrence(store, current);
+    return 1;
+}
+
+/**
+ * @brief Cancels an occurrence by ID (no user interaction).
+ */
+int cancelOccurrence(OccurrenceStore* store, int id) {
+    Occurrence* current = findOccurrence(store, id);
+    if (!current) return 0;
+    current->status = OCCURRENCE_INACTIVE;
+    touchOccurrence(store, current);
+    return 1;
+}
+
 /**
  * @brief Cancels an occurrence (Soft Delete).
  */
-OccurrenceNode* deleteOccurrence(OccurrenceNode* head) {
-    int id = getInt(1, 99999, "ID a cancelar: ");
-    OccurrenceNode* current = head;
-    while(current) {
-        if(current->data.id == id) {
-            current->data.status = OCCURRENCE_INACTIVE;
-            printf("Ocorrência cancelada.\n");
-            return head;
-        }
-        current = current->next;
+void deleteOccurrence(OccurrenceStore* store) {
+    int id = getInt(1, MAX_ID, "ID a cancelar: ");
+    if(cancelOccurrence(store, id)) {
+        printf("Ocorrência cancelada.\n");
+        return;
     }
     printf("ID não encontrado.\n");
-    return head;
 }
 
 /**
- * @brief REPORT: Stats by location.
+ * @brief Arguments of the partitioned location count.
  */
-void listOccurrenceStats(OccurrenceNode* head) {
-    if(!head) { printf("Sem dados para estatísticas.\n"); return; }
+typedef struct {
+    const OccurrenceStore* store;
+    int groupBy;
+    Aggregation partial[PARALLEL_MAX_WORKERS];
+} GroupTask;
 
-    printf("\n--- ANÁLISE POR LOCALIZAÇÃO E FREQUÊNCIA ---\n");
+/**
+ * @brief Counts the active occurrences of slots [from, to) into the partial aggregation of the partition.
+ */
+static void countGroups(void* context, int part, int from, int to) {
+    GroupTask* job = (GroupTask*) context;
+    Aggregation* aggregation = &job->partial[part];
+    int i;
 
-    OccurrenceNode* outer = head;
-    while (outer) {
-        if (outer->data.status == OCCURRENCE_INACTIVE) { outer = outer->next; continue; }
+    for (i = from; i < to; i++) {
+        const Occurrence* current = &job->store->items[i];
+        if (current->status == OCCURRENCE_INACTIVE) continue;
+        aggregationAdd(aggregation, current->location,
+                       (job->groupBy & GROUP_BY_TYPE) ? (int) current->type : -1,
+                       (job->groupBy & GROUP_BY_PRIORITY) ? (int) current->priority : -1, 1);
+    }
+}
 
-        int duplicate = 0;
-        OccurrenceNode* checker = head;
-        while(checker != outer) {
-            if(strcmp(checker->data.location, outer->data.location) == 0 && checker->data.status != OCCURRENCE_INACTIVE) {
-                duplicate = 1;
-                break;
-            }
-            checker = checker->next;
-        }
+/**
+ * @brief REPORT: Stats by location (partitioned hash aggregation).
+ */
+void listOccurrenceStats(const OccurrenceStore* store, int groupBy, int topN) {
+    GroupTask job;
+    Aggregation aggregation;
+    int parts, i;
+    if(store->count == 0) { printf("Sem dados para estatísticas.\n"); return; }
 
-        if (!duplicate) {
-            int count = 0;
-            OccurrenceNode* inner = outer;
-            while(inner) {
-                if(strcmp(inner->data.location, outer->data.location) == 0 && inner->data.status != OCCURRENCE_INACTIVE) {
-                    count++;
-                }
-                inner = inner->next;
-            }
-            printf("- %s: %d incidente(s)\n", outer->data.location, count);
-        }
-        outer = outer->next;
+    // Each partition counts into its own aggregation; the partial counts are merged at the end.
+    job.store = store;
+    job.groupBy = groupBy;
+    for (i = 0; i < PARALLEL_MAX_WORKERS; i++) aggregationInit(&job.partial[i]);
+    parts = parallelFor(store->count, PARALLEL_MIN_CHUNK, countGroups, &job);
+    aggregation = job.partial[0];
+    for (i = 1; i < parts; i++) {
+        aggregationMerge(&aggregation, &job.partial[i]);
+        aggregationFree(&job.partial[i]);
     }
-}
+    aggregationSort(&aggregation);
 
-void saveOccurrences(OccurrenceNode* head) {
-    FILE* fp = fopen(FILE_OCCURRENCES, "wb");
-    if (!fp) return;
-    while(head){
-        fwrite(&head->data, sizeof(Occurrence), 1, fp);
-        head = head->next;
+    printf("\n--- ANÁLISE POR LOCALIZAÇÃO E FREQUÊNCIA ---\n");
+    if (topN <= 0 || topN > aggregation.count) topN = aggregation.count;
+    for (i = 0; i < topN; i++) {
+        const GroupCount* group = &aggregation.groups[i];
+        printf("- %s", symbolText(group->location));
+        if (group->type >= 0 && group->priority >= 0) printf(" [%s, %s]", TYPE_NAMES[group->type], PRIORITY_NAMES[group->priority]);
+        else if (group->type >= 0) printf(" [%s]", TYPE_NAMES[group->type]);
+        else if (group->priority >= 0) printf(" [%s]", PRIORITY_NAMES[group->priority]);
+        printf(": %d incidente(s)\n", group->count);
     }
-    fclose(fp);
+    aggregationFree(&aggregation);
 }
 
-OccurrenceNode* loadOccurrences(int* idSeq) {
-    FILE* fp = fopen(FILE_OCCURRENCES, "rb");
-    if (!fp) return NULL;
-    OccurrenceNode* head = NULL;
-    Occurrence temp;
+/**
+ * @brief Accepts a loaded record only if its type, priority and status can index the derived structures.
+ */
+static int validOccurrence(const void* record) {
+    const Occurrence* occurrence = (const Occurrence*) record;
+    return (int) occurrence->type >= FOREST && (int) occurrence->type <= INDUSTRIAL &&
+           (int) occurrence->priority >= LOW && (int) occurrence->priority <= HIGH &&
+           (int) occurrence->status >= REPORTED && (int) occurrence->status <= OCCURRENCE_INACTIVE;
+}
+
+int saveOccurrences(OccurrenceStore* store) {
+    // The saved cube stops matching once the data file changes; it is written again at close.
+    rollupDiscard(&store->rollup, FILE_ROLLUP);
+    return storeFlush(FILE_OCCURRENCES, OCCURRENCES_MAGIC, OCCURRENCES_VERSION, store->items, store->count, sizeof(Occurrence), &store->dirty, &store->persistedCount);
+}
+
+int saveOccurrenceRollup(OccurrenceStore* store) {
+    return rollupSave(&store->rollup, FILE_ROLLUP, store->count);
+}
+
+void loadOccurrences(OccurrenceStore* store, int* idSeq) {
+    int i;
+
+    idIndexInit(&store->index);
+    store->byTime = NULL;
+    store->byTimeCapacity = 0;
+    heapInit(&store->dispatch, moreUrgent, store);
+    histogramGridInit(&store->resolutionTimes, TYPE_PRIORITY_CELLS);
+    columnInit(&store->statusColumn);
+    columnInit(&store->typeColumn);
+    columnInit(&store->priorityColumn);
+    rollupInit(&store->rollup);
     *idSeq = 0;
-    while(fread(&temp, sizeof(Occurrence), 1, fp)){
-        OccurrenceNode* newNode = (OccurrenceNode*)malloc(sizeof(OccurrenceNode));
-        newNode->data = temp;
-        newNode->next = head;
-        head = newNode;
-        if(temp.id > *idSeq) *idSeq = temp.id;
+    storeLoad(FILE_OCCURRENCES, OCCURRENCES_MAGIC, OCCURRENCES_VERSION, (void**) &store->items, &store->count, &store->capacity,
+              &store->mappedSize, sizeof(Occurrence), validOccurrence);
+    store->persistedCount = store->count;
+    store->dirty = (unsigned char*) calloc(store->count > 0 ? store->count : 1, 1);
+
+    for (i = 0; i < store->count; i++) {
+        idIndexPut(&store->index, store->items[i].id, i);
+        trackDispatch(store, i);
+        trackResolution(store, i);
+        trackColumns(store, i);
+        trackRollup(store, i, 1);
+        if (store->items[i].id > *idSeq) *idSeq = store->items[i].id;
     }
-    fclose(fp);
-    return head;
+    buildTimeIndex(store);
+
+    // The saved cube is only trusted if it was computed from exactly these records.
+    if (!rollupLoad(&store->rollup, FILE_ROLLUP, store->count)) rollupRebuild(&store->rollup, store->count);
+}
+
+void freeOccurrences(OccurrenceStore* store) {
+    storeRelease((void**) &store->items, &store->count, &store->capacity, &store->mappedSize);
+    free(store->dirty);
+    store->dirty = NULL;
+    store->persistedCount = 0;
+    free(store->byTime);
+    store->byTime = NULL;
+    store->byTimeCapacity = 0;
+    idIndexFree(&store->index);
+    heapFree(&store->dispatch);
+    histogramGridFree(&store->resolutionTimes);
+    columnFree(&store->statusColumn);
+    columnFree(&store->typeColumn);
+    columnFree(&store->priorityColumn);
+    rollupFree(&store->rollup);
+}
+
+/**
+ * @brief Returns the display name of an occurrence type.
+ */
+const char* occurrenceTypeName(OccurrenceType type) {
+    return TYPE_NAMES[type];
 }
 
-void freeOccurrences(OccurrenceNode* head) {
-    OccurrenceNode* temp;
-    while(head){
-        temp = head;
-        head = head->next;
-        free(temp);
+/**
+ * @brief Returns the display name of a priority.
+ */
+const char* priorityName(Priority priority) {
+    return PRIORITY_NAMES[priority];
+}
+
+/**
+ * @brief Tells whether a text contains a lowercase keyword, ignoring the case of the text.
+ */
+static int containsKeyword(const char* text, const char* keyword) {
+    size_t length = strlen(keyword);
+    for (; *text; text++) {
+        size_t i = 0;
+        while (i < length && tolower((unsigned char) text[i]) == (unsigned char) keyword[i]) i++;
+        if (i == length) return 1;
     }
-}
\ No newline at end of file
+    return 0;
+}
+
+/**
+ * @brief Tells whether a text (specialty, equipment type, ...) suits an occurrence type.
+ */
+int textMatchesType(Symbol text, OccurrenceType type) {
+    const char* value = symbolText(text);
+    int i;
+    for (i = 0; TYPE_KEYWORDS[type][i]; i++) {
+        if (containsKeyword(value, TYPE_KEYWORDS[type][i])) return 1;
+    }
+    return 0;
+}
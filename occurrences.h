@@ -17,67 +17,281 @@
 /**
  * @brief Displays the Occurrence management menu.
  *
- * @param head Double pointer to the head of the linked list.
+ * @param store Pointer to the occurrence store.
  * @param idSeq Pointer to the ID sequence counter.
  */
-void menuOccurrences(OccurrenceNode** head, int* idSeq);
+void menuOccurrences(OccurrenceStore* store, int* idSeq);
 
 /**
- * @brief Creates a new occurrence and adds it to the list.
+ * @brief Registers a new REPORTED occurrence from its fields, without user interaction.
  *
- * @param head Pointer to the current head of the linked list.
+ * @param store Pointer to the occurrence store.
  * @param idSeq Pointer to the ID sequence counter.
- * @return Returns the new head of the linked list.
+ * @param location Symbol of the location.
+ * @param type Occurrence type.
+ * @param priority Priority.
+ * @param timestamp Date and time of the occurrence.
+ * @return Returns the new occurrence, or NULL if memory could not be allocated.
  */
-OccurrenceNode* createOccurrence(OccurrenceNode* head, int* idSeq);
+Occurrence* addOccurrence(OccurrenceStore* store, int* idSeq, Symbol location, OccurrenceType type,
+                          Priority priority, Timestamp timestamp);
+
+/**
+ * @brief Creates a new occurrence and adds it to the store.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param idSeq Pointer to the ID sequence counter.
+ * @return Returns the new occurrence, or NULL if memory could not be allocated.
+ */
+Occurrence* createOccurrence(OccurrenceStore* store, int* idSeq);
+
+/**
+ * @brief Appends an occurrence record to the store and indexes it by ID.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param record Record to copy into the store.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Occurrence* insertOccurrence(OccurrenceStore* store, const Occurrence* record);
+
+/**
+ * @brief Appends many occurrence records at once (bulk import).
+ *
+ * Unlike repeated insertOccurrence calls, records in any date order cost O(n log n) in total:
+ * the time index is sorted once at the end instead of shifted for every record. The records
+ * are not journaled; they reach the data file with the next save.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param records Records to copy into the store (their IDs must be new).
+ * @param count Number of records.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int appendOccurrences(OccurrenceStore* store, const Occurrence* records, int count);
+
+/**
+ * @brief Stores a new version of a record: replaces the record with the same ID or appends it.
+ *
+ * Used when replaying the journal; keeps every structure derived from the store up to date.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param record New version of the record.
+ * @return Returns the stored record, or NULL if memory could not be allocated.
+ */
+Occurrence* upsertOccurrence(OccurrenceStore* store, const Occurrence* record);
+
+/**
+ * @brief Records that an occurrence was modified: flags it for the next save and journals it.
+ *
+ * Must be called after every change to a record already in the store.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param record Pointer to the modified record (inside the store).
+ */
+void touchOccurrence(OccurrenceStore* store, const Occurrence* record);
 
 /**
  * @brief Lists all registered occurrences.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the occurrence store.
+ */
+void listOccurrences(const OccurrenceStore* store);
+
+/**
+ * @brief Finds the occurrences whose timestamp lies in a date range (binary search on the time index).
+ *
+ * @param store Pointer to the occurrence store.
+ * @param from Start of the range (inclusive).
+ * @param to End of the range (inclusive).
+ * @param first Pointer to receive the position in store->byTime of the first occurrence in the range.
+ * @return Returns the number of occurrences in the range (store->byTime[*first] onwards).
+ */
+int findOccurrencesInRange(const OccurrenceStore* store, Timestamp from, Timestamp to, int* first);
+
+/**
+ * @brief Lists the active occurrences of a date range in chronological order.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param from Start of the range (inclusive).
+ * @param to End of the range (inclusive).
+ */
+void listOccurrencesInRange(const OccurrenceStore* store, Timestamp from, Timestamp to);
+
+/**
+ * @brief Counts the occurrences with a status, type and priority.
+ *
+ * Reads the byte columns of the store with vector instructions instead of the records.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param status OccurrenceStatus to match, or -1 for any.
+ * @param type OccurrenceType to match, or -1 for any.
+ * @param priority Priority to match, or -1 for any.
+ * @return Returns the number of matching occurrences.
+ */
+int countOccurrences(const OccurrenceStore* store, int status, int type, int priority);
+
+/**
+ * @brief Lists the active occurrences with a status and type (filtered on the byte columns).
+ *
+ * @param store Pointer to the occurrence store.
+ * @param status OccurrenceStatus to match, or -1 for any.
+ * @param type OccurrenceType to match, or -1 for any.
+ */
+void listOccurrencesMatching(const OccurrenceStore* store, int status, int type);
+
+/**
+ * @brief Returns the next occurrence to dispatch: the most urgent REPORTED one.
+ *
+ * Urgency is the priority, then the age (oldest timestamp first). The dispatch queue is a binary
+ * heap kept current on insert and touch, so this is O(1) and every change is O(log n).
+ *
+ * @param store Pointer to the occurrence store.
+ * @return Returns the occurrence, or NULL if none is waiting.
  */
-void listOccurrences(OccurrenceNode* head);
+Occurrence* nextToDispatch(OccurrenceStore* store);
+
+/**
+ * @brief Lists the first occurrences of the dispatch queue, in dispatch order.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param limit Maximum number of occurrences to list (at most 16).
+ */
+void listDispatchQueue(const OccurrenceStore* store, int limit);
+
+/**
+ * @brief Changes the priority of an active occurrence, without user interaction.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param id ID of the occurrence.
+ * @param priority New priority.
+ * @return Returns 1 on success, 0 if the occurrence does not exist or is inactive.
+ */
+int changeOccurrencePriority(OccurrenceStore* store, int id, Priority priority);
+
+/**
+ * @brief Changes the priority of an occurrence (repositions it in the dispatch queue).
+ *
+ * @param store Pointer to the occurrence store.
+ */
+void updateOccurrencePriority(OccurrenceStore* store);
+
+/**
+ * @brief Changes the status and end date of an active occurrence, without user interaction.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param id ID of the occurrence.
+ * @param status New status.
+ * @param endedAt End date (NO_TIMESTAMP if it has not ended).
+ * @return Returns 1 on success, 0 if the occurrence does not exist or is inactive.
+ */
+int changeOccurrenceStatus(OccurrenceStore* store, int id, OccurrenceStatus status, Timestamp endedAt);
+
+/**
+ * @brief Cancels an occurrence (soft delete), without user interaction.
+ *
+ * @param store Pointer to the occurrence store.
+ * @param id ID of the occurrence.
+ * @return Returns 1 on success, 0 if the occurrence does not exist.
+ */
+int cancelOccurrence(OccurrenceStore* store, int id);
 
 /**
  * @brief Updates the state or details of an occurrence.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the occurrence store.
  */
-void updateOccurrence(OccurrenceNode* head);
+void updateOccurrence(OccurrenceStore* store);
 
 /**
  * @brief Cancels an occurrence (Soft delete).
  *
- * @param head Pointer to the head of the linked list.
- * @return Returns the head of the linked list.
+ * @param store Pointer to the occurrence store.
  */
-OccurrenceNode* deleteOccurrence(OccurrenceNode* head);
+void deleteOccurrence(OccurrenceStore* store);
 
 /**
  * @brief Saves occurrences to a binary file.
  *
- * @param head Pointer to the head of the linked list.
+ * Only records changed since the last save are rewritten (in place); new records are appended.
+ * A saved rollup cube is removed first, as it no longer matches (see saveOccurrenceRollup).
+ *
+ * @param store Pointer to the occurrence store.
+ * @return Returns 1 on success, 0 if the file could not be written.
  */
-void saveOccurrences(OccurrenceNode* head);
+int saveOccurrences(OccurrenceStore* store);
+
+/**
+ * @brief Saves the rollup cube next to the occurrence file (FILE_ROLLUP).
+ *
+ * Called once when the program closes, after the last saveOccurrences, so periodic checkpoints
+ * cost only what changed and the next start skips recomputing the cube.
+ *
+ * @param store Pointer to the occurrence store.
+ * @return Returns 1 on success, 0 if the file could not be written.
+ */
+int saveOccurrenceRollup(OccurrenceStore* store);
 
 /**
  * @brief Loads occurrences from a binary file.
  *
+ * @param store Pointer to the store to fill (always initialized, even if the file does not exist).
  * @param idSeq Pointer to store the highest ID found.
- * @return Returns the pointer to the head of the loaded linked list.
  */
-OccurrenceNode* loadOccurrences(int* idSeq);
+void loadOccurrences(OccurrenceStore* store, int* idSeq);
+
+/**
+ * @brief Finds an occurrence by ID using the hash index (constant time).
+ *
+ * @param store Pointer to the occurrence store.
+ * @param id ID of the occurrence to find.
+ * @return Returns the occurrence, or NULL if the ID does not exist.
+ * @note The pointer is only valid until the next insertion into the store.
+ */
+Occurrence* findOccurrence(OccurrenceStore* store, int id);
 
 /**
  * @brief Frees memory allocated for occurrences.
  *
- * @param head Pointer to the head of the linked list.
+ * @param store Pointer to the occurrence store.
  */
-void freeOccurrences(OccurrenceNode* head);
+void freeOccurrences(OccurrenceStore* store);
 
 /**
  * @brief Reports analysis by location and frequency.
+ *
+ * Occurrences are counted with a hash aggregation and listed from the most frequent group to the
+ * least frequent one. Large stores are split into partitions counted in parallel (see parallel.h).
+ *
+ * @param store Pointer to the occurrence store.
+ * @param groupBy Additional grouping keys (GROUP_BY_TYPE and/or GROUP_BY_PRIORITY, 0 for location only).
+ * @param topN Maximum number of groups to list (0 lists all of them).
+ */
+void listOccurrenceStats(const OccurrenceStore* store, int groupBy, int topN);
+
+/**
+ * @brief Returns the display name of an occurrence type (e.g. "Florestal").
+ *
+ * @param type Occurrence type.
+ * @return Returns the name.
+ */
+const char* occurrenceTypeName(OccurrenceType type);
+
+/**
+ * @brief Returns the display name of a priority (e.g. "Alta").
+ *
+ * @param priority Priority.
+ * @return Returns the name.
+ */
+const char* priorityName(Priority priority);
+
+/**
+ * @brief Tells whether a text (specialty, equipment type, ...) suits an occurrence type.
+ *
+ * The text is matched, ignoring case, against keywords of the type (e.g. "florest" for FOREST).
+ *
+ * @param text Symbol of the text to check.
+ * @param type Occurrence type.
+ * @return Returns 1 if the text suits the type, 0 otherwise.
  */
-void listOccurrenceStats(OccurrenceNode* head);
+int textMatchesType(Symbol text, OccurrenceType type);
 
-#endif // OCCURRENCES_H
\ No newline at end of file
+#endif // OCCURRENCES_H
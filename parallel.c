@@ -0,0 +1,130 @@
+/**
+ * @file parallel.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the worker pool.
+ */
+
+#include <pthread.h> // Provides POSIX threads, mutexes and condition variables
+#include <unistd.h>  // Provides sysconf
+
+#include "parallel.h"
+
+static pthread_mutex_t callLock = PTHREAD_MUTEX_INITIALIZER; // One parallelFor at a time
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;     // Guards the job below
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;       // A job was posted (or the pool is stopping)
+static pthread_cond_t done = PTHREAD_COND_INITIALIZER;       // The last partition finished
+
+static pthread_t threads[PARALLEL_MAX_WORKERS];
+static int threadCount = 0;
+static int stopping = 0;
+
+// Current job
+static PartitionTask jobTask;
+static void* jobContext;
+static int jobCount, jobParts, nextPart, unfinished;
+static unsigned long generation = 0;
+
+/**
+ * @brief Returns the number of workers of the pool.
+ */
+int parallelWorkers(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    return cores > PARALLEL_MAX_WORKERS ? PARALLEL_MAX_WORKERS : (int) cores;
+}
+
+/**
+ * @brief Takes partitions of the current job until none is left (called with the lock held).
+ */
+static void runParts(void) {
+    while (nextPart < jobParts) {
+        int part = nextPart++;
+        int from = (int) ((long) jobCount * part / jobParts);
+        int to = (int) ((long) jobCount * (part + 1) / jobParts);
+
+        pthread_mutex_unlock(&lock);
+        jobTask(jobContext, part, from, to);
+        pthread_mutex_lock(&lock);
+        if (--unfinished == 0) pthread_cond_signal(&done);
+    }
+}
+
+/**
+ * @brief Body of a pool thread: waits for jobs and helps with them.
+ */
+static void* workerMain(void* unused) {
+    unsigned long seen = 0;
+
+    (void) unused;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (!stopping && generation == seen) pthread_cond_wait(&wake, &lock);
+        if (stopping) break;
+        seen = generation;
+        runParts();
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts the threads of the pool (the calling thread is the last worker).
+ */
+static void startPool(void) {
+    int wanted = parallelWorkers() - 1;
+    stopping = 0;
+    while (threadCount < wanted && pthread_create(&threads[threadCount], NULL, workerMain, NULL) == 0) threadCount++;
+}
+
+/**
+ * @brief Splits [0, count) into partitions and runs the task on each one, in parallel.
+ */
+int parallelFor(int count, int minChunk, PartitionTask task, void* context) {
+    int parts = parallelWorkers();
+
+    if (minChunk < 1) minChunk = 1;
+    if (parts > count / minChunk) parts = count / minChunk;
+    if (parts <= 1) {
+        task(context, 0, 0, count);
+        return 1;
+    }
+
+    pthread_mutex_lock(&callLock);
+    pthread_mutex_lock(&lock);
+    if (threadCount == 0) startPool();
+    jobTask = task;
+    jobContext = context;
+    jobCount = count;
+    jobParts = parts;
+    nextPart = 0;
+    unfinished = parts;
+    generation++;
+    pthread_cond_broadcast(&wake);
+
+    runParts();
+    while (unfinished > 0) pthread_cond_wait(&done, &lock);
+    pthread_mutex_unlock(&lock);
+    pthread_mutex_unlock(&callLock);
+    return parts;
+}
+
+/**
+ * @brief Stops and joins the threads of the pool.
+ */
+void parallelShutdown(void) {
+    int i;
+
+    pthread_mutex_lock(&callLock);
+    pthread_mutex_lock(&lock);
+    stopping = 1;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+    for (i = 0; i < threadCount; i++) pthread_join(threads[i], NULL);
+    threadCount = 0;
+    pthread_mutex_unlock(&callLock);
+}
@@ -0,0 +1,60 @@
+/**
+ * @file parallel.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the worker pool used to run reports over partitions of a store.
+ *
+ * A report splits its records into contiguous partitions, aggregates each one into a partial
+ * result of its own (no sharing, so no locking) and merges the partial results at the end.
+ * The pool has one thread per processor core (the calling thread is one of them) and is
+ * started on first use.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/**
+ * @brief Largest number of partitions (and threads) used.
+ */
+#define PARALLEL_MAX_WORKERS 64
+
+/**
+ * @brief Fewest records worth a partition of their own; smaller inputs run on the calling thread.
+ */
+#define PARALLEL_MIN_CHUNK 16384
+
+/**
+ * @brief Work done on one partition: records [from, to) into the partial result number part.
+ */
+typedef void (*PartitionTask)(void* context, int part, int from, int to);
+
+/**
+ * @brief Returns the number of workers of the pool (processor cores, at most PARALLEL_MAX_WORKERS).
+ *
+ * @return Returns the most partitions parallelFor can use (size of the partial results array).
+ */
+int parallelWorkers(void);
+
+/**
+ * @brief Splits [0, count) into partitions and runs the task on each one, in parallel.
+ *
+ * Returns once every partition is done. Calls from several threads are run one at a time.
+ *
+ * @param count Number of records.
+ * @param minChunk Fewest records per partition.
+ * @param task Work done on each partition.
+ * @param context Argument passed to the task.
+ * @return Returns the number of partitions used (partial results 0 to n - 1 were filled).
+ */
+int parallelFor(int count, int minChunk, PartitionTask task, void* context);
+
+/**
+ * @brief Stops and joins the threads of the pool (it is started again if used afterwards).
+ */
+void parallelShutdown(void);
+
+#endif // PARALLEL_H
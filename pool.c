@@ -0,0 +1,80 @@
+/**
+ * @file pool.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the chunked pool allocator.
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+
+#include "pool.h"
+
+/**
+ * @brief Initializes an empty pool.
+ */
+void poolInit(Pool* pool, size_t objectSize, int objectsPerChunk) {
+    // Every object must be able to hold the free list link and keep pointer alignment.
+    if (objectSize < sizeof(void*)) objectSize = sizeof(void*);
+    objectSize = (objectSize + sizeof(PoolChunk) - 1) / sizeof(PoolChunk) * sizeof(PoolChunk);
+
+    pool->objectSize = objectSize;
+    pool->objectsPerChunk = objectsPerChunk > 0 ? objectsPerChunk : 1;
+    pool->chunks = NULL;
+    pool->freeList = NULL;
+    pool->cursor = NULL;
+    pool->remaining = 0;
+}
+
+/**
+ * @brief Allocates one object, reusing a freed one when available.
+ */
+void* poolAlloc(Pool* pool) {
+    void* object;
+
+    if (pool->freeList) {
+        object = pool->freeList;
+        pool->freeList = *(void**) object;
+        return object;
+    }
+
+    if (pool->remaining == 0) {
+        PoolChunk* chunk = (PoolChunk*) malloc(sizeof(PoolChunk) + pool->objectSize * pool->objectsPerChunk);
+        if (!chunk) return NULL;
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+        pool->cursor = (char*) (chunk + 1);
+        pool->remaining = pool->objectsPerChunk;
+    }
+
+    object = pool->cursor;
+    pool->cursor += pool->objectSize;
+    pool->remaining--;
+    return object;
+}
+
+/**
+ * @brief Returns an object to the pool's free list.
+ */
+void poolFree(Pool* pool, void* object) {
+    if (!object) return;
+    *(void**) object = pool->freeList;
+    pool->freeList = object;
+}
+
+/**
+ * @brief Releases every chunk of the pool.
+ */
+void poolRelease(Pool* pool) {
+    while (pool->chunks) {
+        PoolChunk* next = pool->chunks->next;
+        free(pool->chunks);
+        pool->chunks = next;
+    }
+    pool->freeList = NULL;
+    pool->cursor = NULL;
+    pool->remaining = 0;
+}
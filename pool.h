@@ -0,0 +1,72 @@
+/**
+ * @file pool.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares a pool allocator that hands out fixed-size objects from large chunks.
+ *
+ * Objects are carved sequentially from chunks, freed objects are recycled through a free list,
+ * and releasing the pool frees whole chunks at once instead of one object at a time.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h> // Provides size_t
+
+/**
+ * @brief Header of a chunk of objects (the objects follow it in memory).
+ */
+typedef union PoolChunk {
+    union PoolChunk* next;
+    double align; /**< Keeps the objects that follow the header suitably aligned. */
+} PoolChunk;
+
+/**
+ * @brief Pool of fixed-size objects.
+ */
+typedef struct {
+    size_t objectSize;
+    int objectsPerChunk;
+    PoolChunk* chunks;
+    void* freeList;
+    char* cursor;
+    int remaining;
+} Pool;
+
+/**
+ * @brief Initializes an empty pool. No memory is allocated until the first object is requested.
+ *
+ * @param pool Pointer to the pool to initialize.
+ * @param objectSize Size of each object in bytes.
+ * @param objectsPerChunk Number of objects allocated together in each chunk.
+ */
+void poolInit(Pool* pool, size_t objectSize, int objectsPerChunk);
+
+/**
+ * @brief Allocates one object, reusing a freed one when available.
+ *
+ * @param pool Pointer to the pool.
+ * @return Returns the object, or NULL if memory could not be allocated.
+ */
+void* poolAlloc(Pool* pool);
+
+/**
+ * @brief Returns an object to the pool's free list.
+ *
+ * @param pool Pointer to the pool.
+ * @param object Object previously returned by poolAlloc.
+ */
+void poolFree(Pool* pool, void* object);
+
+/**
+ * @brief Releases every chunk of the pool and leaves it empty (ready to be reused).
+ *
+ * @param pool Pointer to the pool.
+ */
+void poolRelease(Pool* pool);
+
+#endif // POOL_H
@@ -0,0 +1,281 @@
+/**
+ * @file rollup.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the rollup cube.
+ */
+
+#include <stdio.h>   // Provides standard input and output functions (e.g., printf, scanf)
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for string manipulation (e.g., memcpy)
+
+#include "rollup.h"
+#include "datetime.h"
+#include "store.h"
+
+#define ROLLUP_MAGIC 0x50554C52 // "RLUP"
+#define ROLLUP_VERSION 2
+
+/**
+ * @brief Header of the rollup file, followed by the cells of each granularity.
+ */
+typedef struct {
+    int magic;
+    int version;
+    int sampleCount; /**< Records the cells were computed from. */
+    int cellCount[ROLLUP_GRANULARITIES];
+} RollupHeader;
+
+/**
+ * @brief Divides rounding towards minus infinity (timestamps before 1970 are negative).
+ */
+static int floorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+/**
+ * @brief Returns the bucket of a timestamp at a granularity.
+ */
+int rollupBucket(int granularity, int timestamp) {
+    DateTime dt;
+    if (granularity == ROLLUP_HOUR) return floorDiv(timestamp, 60);
+    if (granularity == ROLLUP_DAY) return floorDiv(timestamp, 60 * 24);
+    dt = fromTimestamp(timestamp);
+    return (dt.year - 1970) * 12 + dt.month - 1;
+}
+
+/**
+ * @brief Hash of a cell key.
+ */
+static unsigned int hashKey(int bucket, int type, int priority, int location) {
+    unsigned int hash = (unsigned int) location * 2654435761u;
+    hash ^= (unsigned int) bucket * 2246822519u;
+    hash ^= (unsigned int) (type * 3 + priority + 1) * 40503u;
+    return hash ^ (hash >> 15);
+}
+
+/**
+ * @brief Finds the table position of a key (either its cell or the empty slot where it belongs).
+ */
+static int probe(const RollupLevel* level, int bucket, int type, int priority, int location) {
+    unsigned int mask = (unsigned int) level->tableSize - 1;
+    unsigned int pos = hashKey(bucket, type, priority, location) & mask;
+    while (level->table[pos] >= 0) {
+        const RollupCell* cell = &level->cells[level->table[pos]];
+        if (cell->bucket == bucket && cell->type == type && cell->priority == priority && cell->location == location) break;
+        pos = (pos + 1) & mask;
+    }
+    return (int) pos;
+}
+
+/**
+ * @brief Resizes the hash table to hold at least twice the cells and reinserts them.
+ */
+static int growTable(RollupLevel* level, int needed) {
+    int newSize = level->tableSize ? level->tableSize : 64;
+    int* newTable;
+    int i;
+
+    while (newSize < needed * 2) newSize *= 2;
+    newTable = (int*) malloc(sizeof(int) * newSize);
+    if (!newTable) return 0;
+    for (i = 0; i < newSize; i++) newTable[i] = -1;
+    free(level->table);
+    level->table = newTable;
+    level->tableSize = newSize;
+    for (i = 0; i < level->count; i++) {
+        const RollupCell* cell = &level->cells[i];
+        level->table[probe(level, cell->bucket, cell->type, cell->priority, cell->location)] = i;
+    }
+    return 1;
+}
+
+/**
+ * @brief Adds (sign 1) or removes (sign -1) a contribution in every granularity.
+ */
+static int apply(Rollup* rollup, const RollupSample* sample, int sign) {
+    int granularity;
+    if (sample->type < 0) return 1;
+
+    for (granularity = 0; granularity < ROLLUP_GRANULARITIES; granularity++) {
+        RollupLevel* level = &rollup->levels[granularity];
+        int bucket = rollupBucket(granularity, sample->timestamp);
+        RollupCell* cell;
+        int pos;
+
+        if ((level->count + 1) * 2 > level->tableSize && !growTable(level, level->count + 1)) return 0;
+        pos = probe(level, bucket, sample->type, sample->priority, sample->location);
+        if (level->table[pos] < 0) {
+            if (!storeReserve((void**) &level->cells, &level->capacity, NULL, level->count + 1, sizeof(RollupCell))) return 0;
+            cell = &level->cells[level->count];
+            cell->bucket = bucket;
+            cell->type = sample->type;
+            cell->priority = sample->priority;
+            cell->location = sample->location;
+            cell->count = 0;
+            cell->resolved = 0;
+            cell->durationSum = 0;
+            level->table[pos] = level->count++;
+        }
+        cell = &level->cells[level->table[pos]];
+        cell->count += sign;
+        if (sample->duration >= 0) {
+            cell->resolved += sign;
+            cell->durationSum += (double) sign * sample->duration;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Initializes an empty cube.
+ */
+void rollupInit(Rollup* rollup) {
+    memset(rollup, 0, sizeof(Rollup));
+}
+
+/**
+ * @brief Records the contribution of a record without adding it to the cells.
+ */
+int rollupAttach(Rollup* rollup, int slot, const RollupSample* sample) {
+    int oldCapacity = rollup->sampleCapacity;
+    int i;
+    if (!storeReserve((void**) &rollup->samples, &rollup->sampleCapacity, NULL, slot + 1, sizeof(RollupSample))) return 0;
+    for (i = oldCapacity; i < rollup->sampleCapacity; i++) {
+        memset(&rollup->samples[i], 0, sizeof(RollupSample));
+        rollup->samples[i].type = -1;
+    }
+    rollup->samples[slot] = *sample;
+    return 1;
+}
+
+/**
+ * @brief Sets the contribution of a record, replacing its previous one.
+ */
+int rollupTrack(Rollup* rollup, int slot, const RollupSample* sample) {
+    if (slot < rollup->sampleCapacity) {
+        const RollupSample* previous = &rollup->samples[slot];
+        if (memcmp(previous, sample, sizeof(RollupSample)) == 0) return 1;
+        if (!apply(rollup, previous, -1)) return 0;
+    }
+    return rollupAttach(rollup, slot, sample) && apply(rollup, sample, 1);
+}
+
+/**
+ * @brief Rebuilds the cells from the recorded contributions.
+ */
+int rollupRebuild(Rollup* rollup, int count) {
+    int granularity, i;
+    for (granularity = 0; granularity < ROLLUP_GRANULARITIES; granularity++) rollup->levels[granularity].count = 0;
+    for (granularity = 0; granularity < ROLLUP_GRANULARITIES; granularity++) {
+        RollupLevel* level = &rollup->levels[granularity];
+        for (i = 0; i < level->tableSize; i++) level->table[i] = -1;
+    }
+    for (i = 0; i < count && i < rollup->sampleCapacity; i++) {
+        if (!apply(rollup, &rollup->samples[i], 1)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns the cells of a granularity.
+ */
+const RollupCell* rollupCells(const Rollup* rollup, int granularity, int* count) {
+    *count = rollup->levels[granularity].count;
+    return rollup->levels[granularity].cells;
+}
+
+/**
+ * @brief Saves the cells to a binary file (written whole, then renamed over the old one).
+ */
+int rollupSave(Rollup* rollup, const char* path, int count) {
+    RollupHeader header;
+    size_t size = sizeof(RollupHeader);
+    char* buffer;
+    char* cursor;
+    int granularity, ok;
+
+    header.magic = ROLLUP_MAGIC;
+    header.version = ROLLUP_VERSION;
+    header.sampleCount = count;
+    for (granularity = 0; granularity < ROLLUP_GRANULARITIES; granularity++) {
+        header.cellCount[granularity] = rollup->levels[granularity].count;
+        size += (size_t) header.cellCount[granularity] * sizeof(RollupCell);
+    }
+
+    buffer = (char*) malloc(size);
+    if (!buffer) return 0;
+    memcpy(buffer, &header, sizeof(RollupHeader));
+    cursor = buffer + sizeof(RollupHeader);
+    for (granularity = 0; granularity < ROLLUP_GRANULARITIES; granularity++) {
+        size_t bytes = (size_t) header.cellCount[granularity] * sizeof(RollupCell);
+        if (bytes) memcpy(cursor, rollup->levels[granularity].cells, bytes);
+        cursor += bytes;
+    }
+    ok = storeSave(path, buffer, (int) size, 1);
+    free(buffer);
+    rollup->saved = ok;
+    return ok;
+}
+
+/**
+ * @brief Removes the cube file (once) before the data file it matches changes.
+ */
+void rollupDiscard(Rollup* rollup, const char* path) {
+    if (!rollup->saved) return;
+    remove(path);
+    rollup->saved = 0;
+}
+
+/**
+ * @brief Loads the cells from a binary file written for the same number of records.
+ */
+int rollupLoad(Rollup* rollup, const char* path, int count) {
+    FILE* fp = fopen(path, "rb");
+    RollupHeader header;
+    int granularity, ok = 1;
+
+    if (!fp) return 0;
+    rollup->saved = 1; // Accepted or not, the file is removed before the data file changes.
+    if (fread(&header, sizeof(RollupHeader), 1, fp) != 1 || header.magic != ROLLUP_MAGIC ||
+        header.version != ROLLUP_VERSION || header.sampleCount != count) {
+        fclose(fp);
+        return 0;
+    }
+
+    for (granularity = 0; ok && granularity < ROLLUP_GRANULARITIES; granularity++) {
+        RollupLevel* level = &rollup->levels[granularity];
+        int cells = header.cellCount[granularity];
+        level->count = 0;
+        ok = cells >= 0 && storeReserve((void**) &level->cells, &level->capacity, NULL, cells > 0 ? cells : 1, sizeof(RollupCell)) &&
+             (cells == 0 || fread(level->cells, sizeof(RollupCell), cells, fp) == (size_t) cells);
+        if (ok) {
+            level->count = cells;
+            ok = growTable(level, cells);
+        }
+    }
+    fclose(fp);
+
+    if (!ok) {
+        for (granularity = 0; granularity < ROLLUP_GRANULARITIES; granularity++) rollup->levels[granularity].count = 0;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Frees all memory used by the cube.
+ */
+void rollupFree(Rollup* rollup) {
+    int granularity;
+    for (granularity = 0; granularity < ROLLUP_GRANULARITIES; granularity++) {
+        free(rollup->levels[granularity].cells);
+        free(rollup->levels[granularity].table);
+    }
+    free(rollup->samples);
+    rollupInit(rollup);
+}
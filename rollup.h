@@ -0,0 +1,169 @@
+/**
+ * @file rollup.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the rollup cube: occurrence counts pre-aggregated by time bucket.
+ *
+ * Every occurrence is counted in one cell per granularity (hour, day and month), keyed by the
+ * bucket, type, priority and location. Cells hold the number of occurrences, how many were
+ * resolved and the sum of their resolution times, so dashboards read cells instead of records.
+ * The cube is kept current on every change and saved next to the occurrence data file when the
+ * program closes, so a restart reads the cells instead of recomputing them.
+ */
+
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+#define ROLLUP_HOUR 0
+#define ROLLUP_DAY 1
+#define ROLLUP_MONTH 2
+#define ROLLUP_GRANULARITIES 3
+
+/**
+ * @brief Aggregated occurrences of one bucket, type, priority and location.
+ */
+typedef struct {
+    int bucket;   /**< Hours, days or months since 1970-01-01 (according to the granularity). */
+    int type;     /**< OccurrenceType. */
+    int priority; /**< Priority. */
+    int location; /**< Symbol of the location. */
+    int count;    /**< Active occurrences. */
+    int resolved; /**< Of which resolved (with an end date). */
+    double durationSum; /**< Sum of the resolution times of the resolved ones, in minutes. */
+} RollupCell;
+
+/**
+ * @brief Cells of one granularity, with an open-addressing hash table over their keys.
+ */
+typedef struct {
+    RollupCell* cells;
+    int count;
+    int capacity;
+    int* table;
+    int tableSize;
+} RollupLevel;
+
+/**
+ * @brief What one occurrence contributes to the cube.
+ */
+typedef struct {
+    int timestamp; /**< Timestamp of the occurrence. */
+    int type;      /**< OccurrenceType, or -1 if the occurrence is not counted (inactive). */
+    int priority;
+    int location;
+    int duration;  /**< Resolution time, or -1 if the occurrence is not resolved. */
+} RollupSample;
+
+/**
+ * @brief Rollup cube of a store.
+ */
+typedef struct {
+    RollupLevel levels[ROLLUP_GRANULARITIES];
+    RollupSample* samples; /**< Contribution of each slot, so a change can be undone before re-adding it. */
+    int sampleCapacity;
+    int saved; /**< A cube file is on disk (it is removed before the data file changes). */
+} Rollup;
+
+/**
+ * @brief Initializes an empty cube.
+ *
+ * @param rollup Pointer to the cube.
+ */
+void rollupInit(Rollup* rollup);
+
+/**
+ * @brief Returns the bucket of a timestamp at a granularity.
+ *
+ * @param granularity ROLLUP_HOUR, ROLLUP_DAY or ROLLUP_MONTH.
+ * @param timestamp Timestamp (minutes since 1970).
+ * @return Returns the number of hours, days or months since 1970-01-01.
+ */
+int rollupBucket(int granularity, int timestamp);
+
+/**
+ * @brief Sets the contribution of a record, replacing its previous one.
+ *
+ * @param rollup Pointer to the cube.
+ * @param slot Slot of the record in its store.
+ * @param sample New contribution.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int rollupTrack(Rollup* rollup, int slot, const RollupSample* sample);
+
+/**
+ * @brief Records the contribution of a record without adding it to the cells (used while loading).
+ *
+ * @param rollup Pointer to the cube.
+ * @param slot Slot of the record in its store.
+ * @param sample Contribution.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int rollupAttach(Rollup* rollup, int slot, const RollupSample* sample);
+
+/**
+ * @brief Rebuilds the cells from the recorded contributions of the first count slots.
+ *
+ * @param rollup Pointer to the cube.
+ * @param count Number of records.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int rollupRebuild(Rollup* rollup, int count);
+
+/**
+ * @brief Returns the cells of a granularity.
+ *
+ * @param rollup Pointer to the cube.
+ * @param granularity ROLLUP_HOUR, ROLLUP_DAY or ROLLUP_MONTH.
+ * @param count Pointer to receive the number of cells.
+ * @return Returns the cells (cells whose occurrences were all removed have count 0).
+ */
+const RollupCell* rollupCells(const Rollup* rollup, int granularity, int* count);
+
+/**
+ * @brief Saves the cells to a binary file, tagged with the number of records they come from.
+ *
+ * Meant to be called once, when the store is closed, right after its data file was saved.
+ *
+ * @param rollup Pointer to the cube.
+ * @param path Path of the file.
+ * @param count Number of records.
+ * @return Returns 1 on success, 0 if the file could not be written.
+ */
+int rollupSave(Rollup* rollup, const char* path, int count);
+
+/**
+ * @brief Removes the cube file before the data file it matches is changed.
+ *
+ * Only the first call after a load or save removes anything. A crash after the data file
+ * changed then finds no cube and rebuilds it, instead of trusting stale cells.
+ *
+ * @param rollup Pointer to the cube.
+ * @param path Path of the file.
+ */
+void rollupDiscard(Rollup* rollup, const char* path);
+
+/**
+ * @brief Loads the cells from a binary file written for the same number of records.
+ *
+ * The file only exists while it matches the data file (see rollupDiscard), so the header is
+ * enough to accept it; no record is read.
+ *
+ * @param rollup Pointer to the cube (with every contribution attached).
+ * @param path Path of the file.
+ * @param count Number of records.
+ * @return Returns 1 if the cells were loaded, 0 if the file is missing or stale (then rebuild).
+ */
+int rollupLoad(Rollup* rollup, const char* path, int count);
+
+/**
+ * @brief Frees all memory used by the cube.
+ *
+ * @param rollup Pointer to the cube.
+ */
+void rollupFree(Rollup* rollup);
+
+#endif // ROLLUP_H
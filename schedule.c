@@ -0,0 +1,184 @@
+/**
+ * @file schedule.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the per-owner interval trees (augmented treaps).
+ */
+
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+
+#include "schedule.h"
+#include "store.h"
+
+#define NODES_PER_CHUNK 256
+
+/**
+ * @brief Tree order: by start, then by item slot (keys are unique).
+ */
+static int precedes(int start, int item, int otherStart, int otherItem) {
+    return start < otherStart || (start == otherStart && item < otherItem);
+}
+
+/**
+ * @brief Recomputes the largest end of a subtree from its children.
+ */
+static void refresh(IntervalNode* node) {
+    node->maxEnd = node->end;
+    if (node->left && node->left->maxEnd > node->maxEnd) node->maxEnd = node->left->maxEnd;
+    if (node->right && node->right->maxEnd > node->maxEnd) node->maxEnd = node->right->maxEnd;
+}
+
+/**
+ * @brief Splits a tree into the nodes before a key and the nodes from it on.
+ */
+static void split(IntervalNode* node, int start, int item, IntervalNode** before, IntervalNode** after) {
+    if (!node) {
+        *before = *after = NULL;
+    } else if (precedes(node->start, node->item, start, item)) {
+        split(node->right, start, item, &node->right, after);
+        refresh(node);
+        *before = node;
+    } else {
+        split(node->left, start, item, before, &node->left);
+        refresh(node);
+        *after = node;
+    }
+}
+
+/**
+ * @brief Joins two trees whose keys are all ordered (every key of a before every key of b).
+ */
+static IntervalNode* merge(IntervalNode* a, IntervalNode* b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->weight > b->weight) {
+        a->right = merge(a->right, b);
+        refresh(a);
+        return a;
+    }
+    b->left = merge(a, b->left);
+    refresh(b);
+    return b;
+}
+
+/**
+ * @brief Removes a node (found by its key) from a tree and returns the new root.
+ */
+static IntervalNode* detach(IntervalNode* root, const IntervalNode* node) {
+    if (!root) return NULL;
+    if (root == node) return merge(root->left, root->right);
+    if (precedes(node->start, node->item, root->start, root->item)) root->left = detach(root->left, node);
+    else root->right = detach(root->right, node);
+    refresh(root);
+    return root;
+}
+
+/**
+ * @brief Returns the position of an owner's tree, creating an empty one if needed.
+ */
+static int ownerTree(Schedule* schedule, int owner) {
+    int position = idIndexGet(&schedule->owners, owner);
+    if (position >= 0) return position;
+
+    if (!storeReserve((void**) &schedule->roots, &schedule->ownerCapacity, NULL, schedule->ownerCount + 1, sizeof(IntervalNode*))) return -1;
+    if (!idIndexPut(&schedule->owners, owner, schedule->ownerCount)) return -1;
+    schedule->roots[schedule->ownerCount] = NULL;
+    return schedule->ownerCount++;
+}
+
+/**
+ * @brief Initializes an empty schedule.
+ */
+void scheduleInit(Schedule* schedule) {
+    idIndexInit(&schedule->owners);
+    schedule->roots = NULL;
+    schedule->ownerCount = 0;
+    schedule->ownerCapacity = 0;
+    schedule->nodeOf = NULL;
+    schedule->nodeCapacity = 0;
+    poolInit(&schedule->nodes, sizeof(IntervalNode), NODES_PER_CHUNK);
+}
+
+/**
+ * @brief Removes the booking of an item.
+ */
+void scheduleClear(Schedule* schedule, int item) {
+    IntervalNode* node;
+    int position;
+
+    if (item < 0 || item >= schedule->nodeCapacity || !schedule->nodeOf[item]) return;
+    node = schedule->nodeOf[item];
+    position = idIndexGet(&schedule->owners, node->owner);
+    schedule->roots[position] = detach(schedule->roots[position], node);
+    schedule->nodeOf[item] = NULL;
+    poolFree(&schedule->nodes, node);
+}
+
+/**
+ * @brief Books (or re-books) the window of an item for an owner.
+ */
+int scheduleSet(Schedule* schedule, int item, int owner, int start, int end) {
+    int oldCapacity = schedule->nodeCapacity;
+    IntervalNode* node;
+    IntervalNode* before;
+    IntervalNode* after;
+    int position, i;
+
+    if (!storeReserve((void**) &schedule->nodeOf, &schedule->nodeCapacity, NULL, item + 1, sizeof(IntervalNode*))) return 0;
+    for (i = oldCapacity; i < schedule->nodeCapacity; i++) schedule->nodeOf[i] = NULL;
+
+    scheduleClear(schedule, item);
+    position = ownerTree(schedule, owner);
+    if (position < 0) return 0;
+    node = (IntervalNode*) poolAlloc(&schedule->nodes);
+    if (!node) return 0;
+
+    node->start = start;
+    node->end = end;
+    node->maxEnd = end;
+    node->item = item;
+    node->owner = owner;
+    // A multiplicative hash of the slot is random enough to keep the treap balanced.
+    node->weight = ((unsigned int) item + 1u) * 2654435761u;
+    node->left = node->right = NULL;
+
+    split(schedule->roots[position], start, item, &before, &after);
+    schedule->roots[position] = merge(merge(before, node), after);
+    schedule->nodeOf[item] = node;
+    return 1;
+}
+
+/**
+ * @brief Finds a booking of an owner that overlaps a window.
+ *
+ * Classic interval tree search: if the left subtree reaches past the window start, an overlap
+ * (if any) must be there, because every other interval starts at or after the end of the window.
+ */
+int scheduleConflict(const Schedule* schedule, int owner, int start, int end) {
+    int position = idIndexGet(&schedule->owners, owner);
+    const IntervalNode* node;
+
+    if (position < 0) return -1;
+    node = schedule->roots[position];
+    while (node) {
+        if (node->start < end && node->end > start) return node->item;
+        if (node->left && node->left->maxEnd > start) node = node->left;
+        else node = node->right;
+    }
+    return -1;
+}
+
+/**
+ * @brief Frees all memory used by the schedule.
+ */
+void scheduleFree(Schedule* schedule) {
+    poolRelease(&schedule->nodes);
+    idIndexFree(&schedule->owners);
+    free(schedule->roots);
+    free(schedule->nodeOf);
+    scheduleInit(schedule);
+}
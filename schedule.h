@@ -0,0 +1,94 @@
+/**
+ * @file schedule.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares per-owner interval trees used to detect overlapping bookings.
+ *
+ * Each owner (e.g. a firefighter) has an interval tree of the time windows booked for it, one per
+ * item (e.g. an intervention). The tree is a treap ordered by start and augmented with the
+ * largest end of each subtree, so checking a window for overlaps takes O(log n).
+ */
+
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include "idindex.h"
+#include "pool.h"
+
+/**
+ * @brief Window of an item in its owner's tree: [start, end).
+ */
+typedef struct IntervalNode {
+    int start;
+    int end;
+    int maxEnd;         /**< Largest end in the subtree rooted here. */
+    int item;           /**< Slot of the booked item. */
+    int owner;
+    unsigned int weight; /**< Treap heap priority. */
+    struct IntervalNode* left;
+    struct IntervalNode* right;
+} IntervalNode;
+
+/**
+ * @brief Bookings of every owner.
+ */
+typedef struct {
+    IdIndex owners;       /**< Owner ID -> position in roots. */
+    IntervalNode** roots; /**< Interval tree of each owner. */
+    int ownerCount;
+    int ownerCapacity;
+    IntervalNode** nodeOf; /**< Node of each item slot, or NULL if the item is not booked. */
+    int nodeCapacity;
+    Pool nodes;
+} Schedule;
+
+/**
+ * @brief Initializes an empty schedule.
+ *
+ * @param schedule Pointer to the schedule.
+ */
+void scheduleInit(Schedule* schedule);
+
+/**
+ * @brief Books (or re-books) the window of an item for an owner, replacing its previous booking.
+ *
+ * @param schedule Pointer to the schedule.
+ * @param item Slot of the item.
+ * @param owner ID of the owner.
+ * @param start Start of the window.
+ * @param end End of the window (exclusive; must be greater than start).
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int scheduleSet(Schedule* schedule, int item, int owner, int start, int end);
+
+/**
+ * @brief Removes the booking of an item (does nothing if it is not booked).
+ *
+ * @param schedule Pointer to the schedule.
+ * @param item Slot of the item.
+ */
+void scheduleClear(Schedule* schedule, int item);
+
+/**
+ * @brief Finds a booking of an owner that overlaps a window, in O(log n).
+ *
+ * @param schedule Pointer to the schedule.
+ * @param owner ID of the owner.
+ * @param start Start of the window.
+ * @param end End of the window (exclusive).
+ * @return Returns the slot of an overlapping item, or -1 if the owner is free.
+ */
+int scheduleConflict(const Schedule* schedule, int owner, int start, int end);
+
+/**
+ * @brief Frees all memory used by the schedule and leaves it empty.
+ *
+ * @param schedule Pointer to the schedule.
+ */
+void scheduleFree(Schedule* schedule);
+
+#endif // SCHEDULE_H
@@ -0,0 +1,406 @@
+/**
+ * @file server.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the dispatch server.
+ */
+
+#include <stdio.h>      // Provides standard input and output functions (e.g., fgets, fprintf)
+#include <stdlib.h>     // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>     // Provides functions for string manipulation (e.g., strncmp, strlen)
+#include <errno.h>      // Provides errno (e.g., EINTR)
+#include <signal.h>     // Provides sigaction and signal masks
+#include <pthread.h>    // Provides POSIX threads and reader-writer locks
+#include <unistd.h>     // Provides close, dup and unlink
+#include <sys/socket.h> // Provides socket, bind, listen and accept
+#include <sys/un.h>     // Provides sockaddr_un
+
+#include "server.h"
+#include "batch.h"
+#include "ingest.h"
+#include "journal.h"
+#include "occurrences.h"
+#include "statistics.h"
+#include "symbols.h"
+#include "datetime.h"
+
+// Locks, in the order they are always taken.
+#define LOCK_FIREFIGHTERS 1
+#define LOCK_OCCURRENCES 2
+#define LOCK_EQUIPMENTS 4
+#define LOCK_INTERVENTIONS 8
+#define LOCK_SYMBOLS 16
+#define LOCK_COUNT 5
+#define LOCK_STORES (LOCK_FIREFIGHTERS | LOCK_OCCURRENCES | LOCK_EQUIPMENTS | LOCK_INTERVENTIONS)
+
+static FirefighterStore* firefighters;
+static OccurrenceStore* occurrences;
+static EquipmentStore* equipments;
+static InterventionStore* interventions;
+static int *idFirefighter, *idOccurrence, *idEquipment, *idIntervention;
+
+static pthread_rwlock_t locks[LOCK_COUNT];
+
+static pthread_mutex_t clientsLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t clientsDone = PTHREAD_COND_INITIALIZER;
+static int clients[SERVER_MAX_CLIENTS];
+static int clientCount = 0;
+
+static IngestQueue ingest;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+/**
+ * @brief Signal handler: asks the accept loop to stop.
+ */
+static void requestStop(int signal) {
+    (void) signal;
+    stopRequested = 1;
+}
+
+/**
+ * @brief Initializes the store locks, preferring writers where the C library allows it.
+ *
+ * glibc's default rwlock lets new readers in while a writer waits, so a steady stream of queries
+ * could hold off every change indefinitely.
+ */
+static void initLocks(void) {
+    pthread_rwlockattr_t attributes;
+    int i;
+
+    pthread_rwlockattr_init(&attributes);
+#if defined(__GLIBC__)
+    pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    for (i = 0; i < LOCK_COUNT; i++) pthread_rwlock_init(&locks[i], &attributes);
+    pthread_rwlockattr_destroy(&attributes);
+}
+
+/**
+ * @brief Takes the locks of a set, exclusive for the stores in exclusive and shared for the others.
+ */
+static void lockSet(int exclusive, int shared) {
+    int i;
+    for (i = 0; i < LOCK_COUNT; i++) {
+        if (exclusive & (1 << i)) pthread_rwlock_wrlock(&locks[i]);
+        else if (shared & (1 << i)) pthread_rwlock_rdlock(&locks[i]);
+    }
+}
+
+/**
+ * @brief Releases the locks of a set, in the reverse order.
+ */
+static void unlockSet(int set) {
+    int i;
+    for (i = LOCK_COUNT - 1; i >= 0; i--) {
+        if (set & (1 << i)) pthread_rwlock_unlock(&locks[i]);
+    }
+}
+
+/**
+ * @brief Locks a batch command changes exclusively, from its code (e.g. "O+").
+ */
+static void commandLocks(const char* line, int* exclusive, int* shared) {
+    *exclusive = 0;
+    *shared = 0;
+    switch (line[0]) {
+        case 'F': *exclusive = LOCK_FIREFIGHTERS; break;
+        case 'O': *exclusive = LOCK_OCCURRENCES; break;
+        case 'E': *exclusive = LOCK_EQUIPMENTS; break;
+        // Interventions change their crew and equipment and classify durations by occurrence.
+        case 'I':
+            *exclusive = LOCK_FIREFIGHTERS | LOCK_EQUIPMENTS | LOCK_INTERVENTIONS;
+            *shared = LOCK_OCCURRENCES;
+            break;
+    }
+    // New records intern their texts; the other firefighter, equipment and intervention changes
+    // read them (availability hooks match specialties and types against the occurrence types).
+    if (line[0] != 'I' && line[1] == '+') *exclusive |= LOCK_SYMBOLS;
+    else if (line[0] == 'F' || line[0] == 'E' || line[0] == 'I') *shared |= LOCK_SYMBOLS;
+}
+
+/**
+ * @brief Folds the journal into the base files once it is long enough (all stores held exclusively).
+ */
+static void checkpointIfDue(void) {
+    if (journalPending() < JOURNAL_CHECKPOINT_ENTRIES) return;
+    lockSet(LOCK_STORES, LOCK_SYMBOLS);
+    // Another client may have checkpointed while this one waited for the locks.
+    if (journalPending() >= JOURNAL_CHECKPOINT_ENTRIES) journalCheckpoint(firefighters, occurrences, equipments, interventions);
+    unlockSet(LOCK_STORES | LOCK_SYMBOLS);
+}
+
+/**
+ * @brief Locks the stores around a batch of the ingest applier (and checkpoints after it).
+ */
+static void lockIngest(void* context, int acquire) {
+    (void) context;
+    if (acquire) {
+        lockSet(LOCK_OCCURRENCES | LOCK_SYMBOLS, 0);
+        return;
+    }
+    unlockSet(LOCK_OCCURRENCES | LOCK_SYMBOLS);
+    checkpointIfDue();
+}
+
+/**
+ * @brief Writes the percentile rows of a grid (type;priority;n;mean;p50;p90;p95;p99).
+ */
+static void writePercentiles(FILE* out, const HistogramGrid* grid) {
+    int type, priority;
+    for (type = 0; type < 3; type++) {
+        for (priority = 0; priority < 3; priority++) {
+            const Histogram* histogram = &grid->cells[TYPE_PRIORITY_CELL(type, priority)];
+            fprintf(out, "%s;%s;%d;%.0f;%d;%d;%d;%d\n", occurrenceTypeName((OccurrenceType) type),
+                    priorityName((Priority) priority), histogram->total, histogramMean(histogram),
+                    histogramPercentile(histogram, 50), histogramPercentile(histogram, 90),
+                    histogramPercentile(histogram, 95), histogramPercentile(histogram, 99));
+        }
+    }
+}
+
+/**
+ * @brief Answers a query (a line starting with '?'); returns 1 if it was understood.
+ */
+static int answerQuery(const char* query, FILE* out) {
+    int value, i;
+
+    if (strcmp(query, "?MONITOR") == 0) {
+        lockSet(0, LOCK_FIREFIGHTERS | LOCK_OCCURRENCES | LOCK_EQUIPMENTS);
+        fprintf(out, "BOMBEIROS;%d;%d\n", firefighters->statusCount[AVAILABLE],
+                firefighters->statusCount[AVAILABLE] + firefighters->statusCount[BUSY]);
+        fprintf(out, "EQUIPAMENTOS;%d;%d\n", equipments->statusCount[OPERATIONAL],
+                equipments->statusCount[OPERATIONAL] + equipments->statusCount[IN_USE] + equipments->statusCount[MAINTENANCE]);
+        fprintf(out, "OCORRENCIAS;%d;%d\n", countOccurrences(occurrences, REPORTED, -1, -1),
+                countOccurrences(occurrences, IN_PROGRESS, -1, -1));
+        unlockSet(LOCK_FIREFIGHTERS | LOCK_OCCURRENCES | LOCK_EQUIPMENTS);
+        return 1;
+    }
+    if (sscanf(query, "?FILA %d", &value) == 1 && value >= 1 && value <= 16) {
+        int slots[16];
+        int n;
+        lockSet(0, LOCK_OCCURRENCES | LOCK_SYMBOLS);
+        n = heapFirst(&occurrences->dispatch, value, slots);
+        for (i = 0; i < n; i++) {
+            const Occurrence* current = &occurrences->items[slots[i]];
+            char date[TIMESTAMP_TEXT];
+            formatTimestamp(current->timestamp, date);
+            fprintf(out, "%d;%s;%d;%d;%s\n", current->id, symbolText(current->location), current->type, current->priority, date);
+        }
+        unlockSet(LOCK_OCCURRENCES | LOCK_SYMBOLS);
+        return 1;
+    }
+    if (strcmp(query, "?RESOLUCAO") == 0) {
+        lockSet(0, LOCK_OCCURRENCES);
+        writePercentiles(out, &occurrences->resolutionTimes);
+        unlockSet(LOCK_OCCURRENCES);
+        return 1;
+    }
+    if (strcmp(query, "?DURACAO") == 0) {
+        lockSet(0, LOCK_INTERVENTIONS);
+        writePercentiles(out, &interventions->durations);
+        unlockSet(LOCK_INTERVENTIONS);
+        return 1;
+    }
+    if (strcmp(query, "?INGESTAO") == 0) {
+        unsigned long submitted, applied, rejected;
+        ingestCounters(&ingest, &submitted, &applied, &rejected);
+        fprintf(out, "INGESTAO;%lu;%lu;%lu;%d\n", submitted, applied, rejected, ingestBacklog(&ingest));
+        return 1;
+    }
+    if (sscanf(query, "?RECOMENDAR %d", &value) == 1) {
+        Recommendation recommendation;
+        int slot, found = 0;
+        lockSet(0, LOCK_FIREFIGHTERS | LOCK_OCCURRENCES | LOCK_EQUIPMENTS);
+        slot = idIndexGet(&occurrences->index, value);
+        if (slot >= 0 && occurrences->items[slot].status != OCCURRENCE_INACTIVE) {
+            recommendResources(firefighters, equipments, occurrences->items[slot].type, occurrences->items[slot].priority, &recommendation);
+            found = 1;
+        }
+        unlockSet(LOCK_FIREFIGHTERS | LOCK_OCCURRENCES | LOCK_EQUIPMENTS);
+        if (!found) return 0;
+
+        fprintf(out, "BOMBEIROS");
+        for (i = 0; i < recommendation.firefighterCount; i++) fprintf(out, ";%d", recommendation.firefighterIds[i]);
+        fprintf(out, "\nEQUIPAMENTOS");
+        for (i = 0; i < recommendation.equipmentCount; i++) fprintf(out, ";%d", recommendation.equipmentIds[i]);
+        fprintf(out, "\n");
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Applies a batch command under the locks of the stores it changes; returns 1 if it was applied.
+ */
+static int applyRequest(char* line) {
+    int exclusive, shared, result;
+
+    commandLocks(line, &exclusive, &shared);
+    lockSet(exclusive, shared);
+    result = applyBatchLine(line, firefighters, idFirefighter, occurrences, idOccurrence,
+                            equipments, idEquipment, interventions, idIntervention);
+    unlockSet(exclusive | shared);
+    if (result > 0) checkpointIfDue();
+    return result;
+}
+
+/**
+ * @brief Body of a client thread: answers its requests until it disconnects.
+ */
+static void* serveClient(void* argument) {
+    int fd = (int) (long) argument;
+    int outFd = dup(fd);
+    FILE* in = fdopen(fd, "r");
+    FILE* out = outFd >= 0 ? fdopen(outFd, "w") : NULL;
+    char line[BATCH_LINE];
+    int i;
+
+    while (in && out && fgets(line, sizeof(line), in)) {
+        char* start = line + strspn(line, " \t");
+        char* end = start + strlen(start);
+        int result;
+        while (end > start && (end[-1] == '\n' || end[-1] == '\r' || end[-1] == ' ')) *--end = '\0';
+
+        if (start[0] == '?') {
+            result = answerQuery(start, out);
+        } else if (strncmp(start, "O>;", 3) == 0) {
+            // Asynchronous report: queued for the applier, answered without waiting for the store.
+            IngestRecord record;
+            result = ingestParse(start + 3, &record) && ingestSubmit(&ingest, &record);
+        } else {
+            result = applyRequest(start);
+        }
+        if (result < 0) continue;
+        fprintf(out, result ? "OK\n" : "ERRO\n");
+        fflush(out);
+    }
+
+    // Leave the list before closing, so the stop never shuts down a reused descriptor.
+    pthread_mutex_lock(&clientsLock);
+    for (i = 0; i < clientCount; i++) {
+        if (clients[i] == fd) clients[i] = clients[--clientCount];
+    }
+    if (clientCount == 0) pthread_cond_signal(&clientsDone);
+    pthread_mutex_unlock(&clientsLock);
+
+    if (out) fclose(out);
+    else if (outFd >= 0) close(outFd);
+    if (in) fclose(in);
+    else close(fd);
+    return NULL;
+}
+
+/**
+ * @brief Starts the thread of a new client (with the stop signals blocked, so they reach the accept loop).
+ */
+static void startClient(int fd) {
+    pthread_attr_t attributes;
+    pthread_t thread;
+    sigset_t stopSignals, previous;
+
+    pthread_mutex_lock(&clientsLock);
+    if (clientCount == SERVER_MAX_CLIENTS) {
+        pthread_mutex_unlock(&clientsLock);
+        close(fd);
+        return;
+    }
+    clients[clientCount++] = fd;
+    pthread_mutex_unlock(&clientsLock);
+
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, &previous);
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread, &attributes, serveClient, (void*) (long) fd) != 0) {
+        int i;
+        pthread_mutex_lock(&clientsLock);
+        for (i = 0; i < clientCount; i++) {
+            if (clients[i] == fd) clients[i] = clients[--clientCount];
+        }
+        pthread_mutex_unlock(&clientsLock);
+        close(fd);
+    }
+    pthread_attr_destroy(&attributes);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+/**
+ * @brief Serves the stores on a Unix socket until SIGINT or SIGTERM.
+ */
+int runServer(const char* path, FirefighterStore* firefighterStore, int* firefighterSeq,
+              OccurrenceStore* occurrenceStore, int* occurrenceSeq,
+              EquipmentStore* equipmentStore, int* equipmentSeq,
+              InterventionStore* interventionStore, int* interventionSeq) {
+    struct sockaddr_un address;
+    struct sigaction action;
+    int listener, i;
+
+    if (strlen(path) >= sizeof(address.sun_path)) return 0;
+    firefighters = firefighterStore;
+    occurrences = occurrenceStore;
+    equipments = equipmentStore;
+    interventions = interventionStore;
+    idFirefighter = firefighterSeq;
+    idOccurrence = occurrenceSeq;
+    idEquipment = equipmentSeq;
+    idIntervention = interventionSeq;
+    initLocks();
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) return 0;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    unlink(path);
+    if (bind(listener, (struct sockaddr*) &address, sizeof(address)) != 0 || listen(listener, 16) != 0) {
+        close(listener);
+        return 0;
+    }
+
+    // No SA_RESTART: the signal interrupts accept, so the loop sees the stop request.
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    stopRequested = 0;
+
+    if (!ingestStart(&ingest, SERVER_INGEST_CAPACITY, occurrences, idOccurrence, lockIngest, NULL)) {
+        close(listener);
+        unlink(path);
+        return 0;
+    }
+
+    fprintf(stderr, "Servidor à escuta em %s.\n", path);
+    while (!stopRequested) {
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+        startClient(client);
+    }
+    close(listener);
+    unlink(path);
+
+    // Disconnect the clients and wait for their threads to let go of the stores.
+    pthread_mutex_lock(&clientsLock);
+    for (i = 0; i < clientCount; i++) shutdown(clients[i], SHUT_RDWR);
+    while (clientCount > 0) pthread_cond_wait(&clientsDone, &clientsLock);
+    pthread_mutex_unlock(&clientsLock);
+
+    // No producer is left: apply what is still queued.
+    ingestStop(&ingest);
+
+    for (i = 0; i < LOCK_COUNT; i++) pthread_rwlock_destroy(&locks[i]);
+    fprintf(stderr, "Servidor terminado.\n");
+    return 1;
+}
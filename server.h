@@ -0,0 +1,68 @@
+/**
+ * @file server.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.1
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the dispatch server: the stores shared by several local clients over a Unix socket.
+ *
+ * Each client sends one request per line and gets zero or more data lines followed by "OK" or
+ * "ERRO". Requests are the commands of the batch mode (see batch.h), asynchronous occurrence
+ * reports, or queries:
+ *
+ *     O>;location;type;priority;date  queues a report (see ingest.h); "ERRO" if the queue is full
+ *
+ *     ?MONITOR           free/total firefighters and equipment, reported/in-progress occurrences
+ *     ?FILA n            first n occurrences of the dispatch queue (id;location;type;priority;date)
+ *     ?RESOLUCAO         resolution time percentiles per type and priority
+ *     ?DURACAO           intervention duration percentiles per type and priority
+ *     ?RECOMENDAR id     firefighters and equipment recommended for an occurrence
+ *     ?INGESTAO          reports queued, applied and refused, and the current backlog
+ *
+ * Every store has a reader-writer lock. Queries take shared locks on the stores they read, and
+ * a command takes exclusive locks only on the stores it changes, so readers never wait for one
+ * another and edits of different stores run at the same time. Locks are always taken in the
+ * same order (firefighters, occurrences, equipment, interventions, symbols), so they cannot
+ * deadlock. Any client tool works, e.g. "socat - UNIX-CONNECT:path".
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "data.h"
+
+/**
+ * @brief Most clients connected at once.
+ */
+#define SERVER_MAX_CLIENTS 64
+
+/**
+ * @brief Slots of the ingest queue of asynchronous reports.
+ */
+#define SERVER_INGEST_CAPACITY 16384
+
+/**
+ * @brief Serves the stores on a Unix socket until SIGINT or SIGTERM.
+ *
+ * Checkpoints the journal every JOURNAL_CHECKPOINT_ENTRIES changes. On return every client
+ * was disconnected; the caller saves and frees the stores.
+ *
+ * @param path Path of the socket (replaced if it exists).
+ * @param firefighters Pointer to the firefighter store.
+ * @param idFirefighter Pointer to the firefighter ID counter.
+ * @param occurrences Pointer to the occurrence store.
+ * @param idOccurrence Pointer to the occurrence ID counter.
+ * @param equipments Pointer to the equipment store.
+ * @param idEquipment Pointer to the equipment ID counter.
+ * @param interventions Pointer to the intervention store.
+ * @param idIntervention Pointer to the intervention ID counter.
+ * @return Returns 1 after a clean stop, 0 if the socket could not be opened.
+ */
+int runServer(const char* path, FirefighterStore* firefighters, int* idFirefighter,
+              OccurrenceStore* occurrences, int* idOccurrence,
+              EquipmentStore* equipments, int* idEquipment,
+              InterventionStore* interventions, int* idIntervention);
+
+#endif // SERVER_H
@@ -2,64 +2,43 @@
  * @file statistics.c
  * @author Afonso Mendes
  * @author Rodrigo Ferreira
- * @version 1.3
+ * @version 1.8
  *
  * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
  *
  * @brief Implementation of strategic reports and additional decision-support tools.
  */
 
-#include <stdio.h> // Provides standard input and output functions (e.g., printf, scanf)
+#include <stdio.h>  // Provides standard input and output functions (e.g., printf, scanf)
+#include <string.h> // Provides functions for memory manipulation (e.g., memset)
 
 #include "statistics.h"
+#include "occurrences.h"
+#include "datetime.h"
+#include "symbols.h"
+#include "parallel.h"
 
-/**
- * @brief Helper function to calculate the difference in minutes between two dates.
- */
-int calcMinutes(DateTime start, DateTime end) {
-    long t1 = start.year * 525600 + start.month * 43200 + start.day * 1440 + start.hour * 60 + start.minute;
-    long t2 = end.year * 525600 + end.month * 43200 + end.day * 1440 + end.hour * 60 + end.minute;
-    return (int)(t2 - t1);
-}
+// Resources sent per Priority (LOW, NORMAL, HIGH).
+static const int FIREFIGHTERS_NEEDED[] = { 2, 4, 6 };
+static const int EQUIPMENT_NEEDED[] = { 1, 2, 3 };
 
 /**
  * @brief ADDITIONAL FUNCTIONALITY: Operational Capacity Monitor.
  *
  * Displays a real-time dashboard showing the percentage of available resources.
- * It strictly ignores INACTIVE (deleted) resources.
+ * It strictly ignores INACTIVE (deleted) resources. Runs in constant time.
  */
-void showOperationalMonitor(FirefighterNode* fHead, EquipmentNode* eHead) {
+void showOperationalMonitor(const FirefighterStore* firefighters, const EquipmentStore* equipments,
+                            const OccurrenceStore* occurrences) {
+    int type;
     printf("\n=== MONITOR DE CAPACIDADE OPERACIONAL ===\n");
 
-    int totalF = 0, freeF = 0;
-    while(fHead) {
-        if (fHead->data.status == FIREFIGHTER_INACTIVE) {
-            fHead = fHead->next;
-            continue;
-        }
-
-        totalF++;
+    // The stores keep per-status counters current, so the dashboard needs no scan.
+    int totalF = firefighters->statusCount[AVAILABLE] + firefighters->statusCount[BUSY];
+    int freeF = firefighters->statusCount[AVAILABLE];
 
-        if(fHead->data.status == AVAILABLE) {
-            freeF++;
-        }
-
-        fHead = fHead->next;
-    }
-
-    int totalE = 0, freeE = 0;
-    while(eHead) {
-        if (eHead->data.status == EQUIPMENT_INACTIVE) {
-            eHead = eHead->next;
-            continue;
-        }
-
-        totalE++;
-        if(eHead->data.status == OPERATIONAL) {
-            freeE++;
-        }
-        eHead = eHead->next;
-    }
+    int totalE = equipments->statusCount[OPERATIONAL] + equipments->statusCount[IN_USE] + equipments->statusCount[MAINTENANCE];
+    int freeE = equipments->statusCount[OPERATIONAL];
 
     printf("Recursos Humanos (Bombeiros):\n");
     if(totalF > 0) {
@@ -83,64 +62,70 @@ void showOperationalMonitor(FirefighterNode* fHead, EquipmentNode* eHead) {
         printf(" -> Sem dados de equipamentos ativos.\n");
     }
 
+    printf("\nOcorrências em Aberto:\n");
+    printf(" -> %d por despachar, %d em curso (%d de prioridade alta)\n",
+           countOccurrences(occurrences, REPORTED, -1, -1), countOccurrences(occurrences, IN_PROGRESS, -1, -1),
+           countOccurrences(occurrences, REPORTED, -1, HIGH) + countOccurrences(occurrences, IN_PROGRESS, -1, HIGH));
+    for (type = 0; type < 3; type++) {
+        printf("    %-10s %d por despachar, %d em curso\n", occurrenceTypeName((OccurrenceType) type),
+               countOccurrences(occurrences, REPORTED, type, -1), countOccurrences(occurrences, IN_PROGRESS, type, -1));
+    }
+
     printf("=========================================\n");
 }
 
 /**
  * @brief REPORT 1: Operational Efficiency Analysis.
  */
-void reportOperationalEfficiency(OccurrenceNode* head) {
+void reportOperationalEfficiency(const OccurrenceStore* occurrences) {
     printf("\n=== RELATÓRIO DE EFICIÊNCIA OPERACIONAL ===\n");
-    printf("Tempo médio de resolução por Tipo de Incidente (minutos):\n");
-
-    int forestTime = 0, forestCount = 0;
-    int urbanTime = 0, urbanCount = 0;
-    int indTime = 0, indCount = 0;
+    printf("Tempo de resolução por Tipo de Incidente e Prioridade (minutos):\n");
+    printPercentileTable(&occurrences->resolutionTimes);
+}
 
-    while(head) {
-        if(head->data.status == OCCURRENCE_INACTIVE || head->data.endedAt.year == 0) {
-            head = head->next;
-            continue;
-        }
+/**
+ * @brief Prints one line of the percentile table.
+ */
+static void printPercentileRow(const char* type, const char* priority, const Histogram* histogram) {
+    if (histogram->total == 0) {
+        printf("%-11s | %-8s | %6d | %8s | %6s | %6s | %6s | %6s\n", type, priority, 0, "-", "-", "-", "-", "-");
+        return;
+    }
+    printf("%-11s | %-8s | %6d | %8.0f | %6d | %6d | %6d | %6d\n", type, priority, histogram->total, histogramMean(histogram),
+           histogramPercentile(histogram, 50), histogramPercentile(histogram, 90),
+           histogramPercentile(histogram, 95), histogramPercentile(histogram, 99));
+}
 
-        if(head->data.status == RESOLVED) {
-            int duration = calcMinutes(head->data.timestamp, head->data.endedAt);
-            if (duration < 0) duration = 0;
+/**
+ * @brief Prints the mean and percentiles of a grid of durations, per occurrence type and priority.
+ */
+void printPercentileTable(const HistogramGrid* grid) {
+    Histogram all, byType;
+    int type, priority;
 
-            if(head->data.type == FOREST) { forestTime += duration; forestCount++; }
-            else if(head->data.type == URBAN) { urbanTime += duration; urbanCount++; }
-            else if(head->data.type == INDUSTRIAL) { indTime += duration; indCount++; }
+    histogramInit(&all);
+    // "MÉDIA" takes two bytes for the accented letter, hence one more column of padding.
+    printf("%-11s | %-8s | %6s | %9s | %6s | %6s | %6s | %6s\n", "TIPO", "PRIOR.", "N", "MÉDIA", "P50", "P90", "P95", "P99");
+    for (type = 0; type < 3; type++) {
+        histogramInit(&byType);
+        for (priority = 0; priority < 3; priority++) histogramMerge(&byType, &grid->cells[TYPE_PRIORITY_CELL(type, priority)]);
+        printPercentileRow(occurrenceTypeName((OccurrenceType) type), "Todas", &byType);
+        for (priority = 0; priority < 3; priority++) {
+            printPercentileRow("", priorityName((Priority) priority), &grid->cells[TYPE_PRIORITY_CELL(type, priority)]);
         }
-        head = head->next;
+        histogramMerge(&all, &byType);
     }
-
-    printf("- FLORESTAL: %d min (média) baseada em %d incidentes resolvidos.\n",
-           forestCount ? forestTime/forestCount : 0, forestCount);
-    printf("- URBANO:    %d min (média) baseada em %d incidentes resolvidos.\n",
-           urbanCount ? urbanTime/urbanCount : 0, urbanCount);
-    printf("- INDUSTRIAL:%d min (média) baseada em %d incidentes resolvidos.\n",
-           indCount ? indTime/indCount : 0, indCount);
+    printPercentileRow("TOTAL", "Todas", &all);
 }
 
 /**
  * @brief REPORT 2: Equipment Usage and Strain Analysis.
  */
-void reportEquipmentStrain(EquipmentNode* head) {
+void reportEquipmentStrain(const EquipmentStore* equipments) {
     printf("\n=== ANÁLISE DE DESGASTE DE EQUIPAMENTO ===\n");
-    int total = 0, maintenance = 0, operational = 0;
-
-    while(head) {
-        if(head->data.status == EQUIPMENT_INACTIVE) {
-            head = head->next;
-            continue;
-        }
-
-        total++;
-        if(head->data.status == MAINTENANCE) maintenance++;
-        if(head->data.status == OPERATIONAL) operational++;
-
-        head = head->next;
-    }
+    // The store keeps per-status counters current, so the report needs no scan.
+    int maintenance = equipments->statusCount[MAINTENANCE], operational = equipments->statusCount[OPERATIONAL];
+    int total = operational + equipments->statusCount[IN_USE] + maintenance;
 
     printf("Total da Frota: %d unidades\n", total);
     printf("Prontidão Operacional: %.1f%%\n", total ? (float)operational/total * 100 : 0);
@@ -153,5 +138,188 @@ void reportEquipmentStrain(EquipmentNode* head) {
     }
 }
 
-void recommendResources(FirefighterNode* fHead, EquipmentNode* eHead) {
+/**
+ * @brief Totals of a part of a date range.
+ */
+typedef struct {
+    int total, resolved;
+    int byType[3], byPriority[3];
+    double resolutionTime;
+} RangeTotals;
+
+/**
+ * @brief Arguments of the partitioned date-range report.
+ */
+typedef struct {
+    const OccurrenceStore* occurrences;
+    int first;
+    RangeTotals partial[PARALLEL_MAX_WORKERS];
+} RangeTask;
+
+/**
+ * @brief Adds up positions [from, to) of the range into the partial totals of the partition.
+ */
+static void countRange(void* context, int part, int from, int to) {
+    RangeTask* job = (RangeTask*) context;
+    RangeTotals* totals = &job->partial[part];
+    int i;
+
+    memset(totals, 0, sizeof(RangeTotals));
+    for (i = job->first + from; i < job->first + to; i++) {
+        const Occurrence* current = &job->occurrences->items[job->occurrences->byTime[i]];
+        if (current->status == OCCURRENCE_INACTIVE) continue;
+
+        totals->total++;
+        totals->byType[current->type]++;
+        totals->byPriority[current->priority]++;
+        if (current->status == RESOLVED && current->endedAt != NO_TIMESTAMP && current->endedAt >= current->timestamp) {
+            totals->resolutionTime += current->endedAt - current->timestamp;
+            totals->resolved++;
+        }
+    }
+}
+
+/**
+ * @brief REPORT 3: Occurrences in a Date Range.
+ */
+void reportOccurrencesInRange(const OccurrenceStore* occurrences, Timestamp from, Timestamp to) {
+    RangeTask job;
+    int n, parts, i, k;
+    int total = 0, resolved = 0;
+    int byType[3] = { 0, 0, 0 }, byPriority[3] = { 0, 0, 0 };
+    double resolutionTime = 0;
+    char fromText[TIMESTAMP_TEXT], toText[TIMESTAMP_TEXT];
+
+    formatTimestamp(from, fromText);
+    formatTimestamp(to, toText);
+    printf("\n=== RELATÓRIO DO PERÍODO %s A %s ===\n", fromText, toText);
+    if (to < from) { printf("Intervalo inválido.\n"); return; }
+
+    job.occurrences = occurrences;
+    n = findOccurrencesInRange(occurrences, from, to, &job.first);
+    parts = parallelFor(n, PARALLEL_MIN_CHUNK, countRange, &job);
+    for (i = 0; i < parts; i++) {
+        const RangeTotals* totals = &job.partial[i];
+        total += totals->total;
+        resolved += totals->resolved;
+        resolutionTime += totals->resolutionTime;
+        for (k = 0; k < 3; k++) {
+            byType[k] += totals->byType[k];
+            byPriority[k] += totals->byPriority[k];
+        }
+    }
+
+    printf("Total de ocorrências: %d\n", total);
+    printf("- Por tipo: Florestal %d | Urbano %d | Industrial %d\n", byType[FOREST], byType[URBAN], byType[INDUSTRIAL]);
+    printf("- Por prioridade: Baixa %d | Normal %d | Alta %d\n", byPriority[LOW], byPriority[NORMAL], byPriority[HIGH]);
+    printf("- Resolvidas: %d (tempo médio de resolução: %.0f min)\n", resolved, resolved ? resolutionTime / resolved : 0.0);
+}
+
+/**
+ * @brief REPORT 4: Monthly Trend.
+ */
+void reportMonthlyTrend(const OccurrenceStore* occurrences, int year) {
+    static const char* MONTH_NAMES[] = { "Jan", "Fev", "Mar", "Abr", "Mai", "Jun", "Jul", "Ago", "Set", "Out", "Nov", "Dez" };
+    int byType[12][3], resolved[12];
+    double resolutionTime[12];
+    int first = (year - 1970) * 12;
+    int cellCount, month, i;
+    const RollupCell* cells = rollupCells(&occurrences->rollup, ROLLUP_MONTH, &cellCount);
+
+    for (month = 0; month < 12; month++) {
+        byType[month][FOREST] = byType[month][URBAN] = byType[month][INDUSTRIAL] = 0;
+        resolved[month] = 0;
+        resolutionTime[month] = 0;
+    }
+    for (i = 0; i < cellCount; i++) {
+        if (cells[i].bucket < first || cells[i].bucket >= first + 12) continue;
+        month = cells[i].bucket - first;
+        byType[month][cells[i].type] += cells[i].count;
+        resolved[month] += cells[i].resolved;
+        resolutionTime[month] += cells[i].durationSum;
+    }
+
+    printf("\n=== TENDÊNCIA MENSAL DE %d ===\n", year);
+    printf("%-3s | %9s | %6s | %10s | %5s | %9s | %12s\n", "MÊS", "FLORESTAL", "URBANO", "INDUSTRIAL", "TOTAL", "RESOLVIDAS", "TEMPO MÉDIO");
+    for (month = 0; month < 12; month++) {
+        int total = byType[month][FOREST] + byType[month][URBAN] + byType[month][INDUSTRIAL];
+        printf("%-3s | %9d | %6d | %10d | %5d | %9d | ", MONTH_NAMES[month], byType[month][FOREST], byType[month][URBAN],
+               byType[month][INDUSTRIAL], total, resolved[month]);
+        if (resolved[month]) printf("%7.0f min\n", resolutionTime[month] / resolved[month]);
+        else printf("%11s\n", "-");
+    }
+}
+
+/**
+ * @brief Takes the first slots of the preferred queue and completes them from the general one.
+ *
+ * The preferred queue is a subset of the general one. When it runs out, every slot in it was
+ * taken, so a slot of the general queue is new exactly when the preferred queue lacks it.
+ */
+static int pickFirst(const Heap* preferred, const Heap* all, int wanted, int* slots) {
+    int candidates[2 * MAX_RECOMMENDED];
+    int found = heapFirst(preferred, wanted, slots);
+    int n, i;
+
+    if (found == wanted) return found;
+    n = heapFirst(all, wanted + found, candidates);
+    for (i = 0; i < n && found < wanted; i++) {
+        if (!heapContains(preferred, candidates[i])) slots[found++] = candidates[i];
+    }
+    return found;
+}
+
+/**
+ * @brief DECISION SUPPORT: Dispatch Recommendation.
+ *
+ * Reads only the first entries of the availability queues: O(k log k) for k recommended resources.
+ */
+void recommendResources(const FirefighterStore* firefighters, const EquipmentStore* equipments,
+                        OccurrenceType type, Priority priority, Recommendation* result) {
+    int slots[MAX_RECOMMENDED];
+    int i;
+
+    result->firefighterCount = pickFirst(&firefighters->availableFor[type], &firefighters->available,
+                                         FIREFIGHTERS_NEEDED[priority], slots);
+    for (i = 0; i < result->firefighterCount; i++) result->firefighterIds[i] = firefighters->items[slots[i]].id;
+
+    result->equipmentCount = pickFirst(&equipments->operationalFor[type], &equipments->operational,
+                                       EQUIPMENT_NEEDED[priority], slots);
+    for (i = 0; i < result->equipmentCount; i++) result->equipmentIds[i] = equipments->items[slots[i]].id;
+}
+
+/**
+ * @brief Displays the dispatch recommendation for an occurrence.
+ */
+void showRecommendation(const FirefighterStore* firefighters, const EquipmentStore* equipments,
+                        const OccurrenceStore* occurrences, int occurrenceId) {
+    Recommendation recommendation;
+    const Occurrence* occurrence;
+    int slot = idIndexGet(&occurrences->index, occurrenceId);
+    int i;
+
+    if (slot < 0 || occurrences->items[slot].status == OCCURRENCE_INACTIVE) {
+        printf("Ocorrência não encontrada.\n");
+        return;
+    }
+    occurrence = &occurrences->items[slot];
+    recommendResources(firefighters, equipments, occurrence->type, occurrence->priority, &recommendation);
+
+    printf("\n=== RECOMENDAÇÃO DE MEIOS (OCORRÊNCIA %d) ===\n", occurrence->id);
+    printf("Bombeiros (%d de %d pedidos):\n", recommendation.firefighterCount, FIREFIGHTERS_NEEDED[occurrence->priority]);
+    for (i = 0; i < recommendation.firefighterCount; i++) {
+        const Firefighter* firefighter = &firefighters->items[idIndexGet(&firefighters->index, recommendation.firefighterIds[i])];
+        printf(" %d. [%d] %s - %s (%d intervenções)%s\n", i + 1, firefighter->id, symbolText(firefighter->name),
+               symbolText(firefighter->specialty), firefighter->totalInterventions,
+               textMatchesType(firefighter->specialty, occurrence->type) ? "" : " *fora da especialidade*");
+    }
+    printf("Equipamentos (%d de %d pedidos):\n", recommendation.equipmentCount, EQUIPMENT_NEEDED[occurrence->priority]);
+    for (i = 0; i < recommendation.equipmentCount; i++) {
+        const Equipment* equipment = &equipments->items[idIndexGet(&equipments->index, recommendation.equipmentIds[i])];
+        printf(" %d. [%d] %s (%s)\n", i + 1, equipment->id, symbolText(equipment->designation), symbolText(equipment->type));
+    }
+    if (recommendation.firefighterCount < FIREFIGHTERS_NEEDED[occurrence->priority] ||
+        recommendation.equipmentCount < EQUIPMENT_NEEDED[occurrence->priority]) {
+        printf("Meios insuficientes! Chamar reforços.\n");
+    }
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 * @file statistics.h
  * @author Afonso Mendes
  * @author Rodrigo Ferreira
- * @version 1.2
+ * @version 1.6
  *
  * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
  *
@@ -14,36 +14,117 @@
 
 #include "data.h"
 
+/**
+ * @brief Largest number of firefighters (or equipment items) in a recommendation.
+ */
+#define MAX_RECOMMENDED 6
+
+/**
+ * @brief Resources recommended for an occurrence, best first.
+ */
+typedef struct {
+    int firefighterIds[MAX_RECOMMENDED];
+    int firefighterCount;
+    int equipmentIds[MAX_RECOMMENDED];
+    int equipmentCount;
+} Recommendation;
+
 /**
  * @brief ADDITIONAL FUNCTIONALITY: Operational Capacity Monitor.
  *
  * Displays a real-time dashboard showing the percentage of available resources (Human and Material).
  * It calculates the ratio of available vs. total resources and issues a critical alert
- * if the capacity drops below 20%.
+ * if the capacity drops below 20%. Reads the per-status counters of the stores (constant time).
+ * The open occurrences are counted by status and type on the byte columns of their store.
  *
- * @param fHead Pointer to the head of the firefighter linked list.
- * @param eHead Pointer to the head of the equipment linked list.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param occurrences Pointer to the occurrence store.
  */
-void showOperationalMonitor(FirefighterNode* fHead, EquipmentNode* eHead);
+void showOperationalMonitor(const FirefighterStore* firefighters, const EquipmentStore* equipments,
+                            const OccurrenceStore* occurrences);
 
 /**
  * @brief COMPLEX REPORT 1: Operational Efficiency Analysis.
  *
- * Calculates and displays the average resolution time (in minutes) for each type of incident
- * (Forest, Urban, Industrial), based on resolved occurrences with valid end dates.
+ * Displays the resolution time (in minutes) for each type of incident (Forest, Urban, Industrial)
+ * and priority: mean and p50/p90/p95/p99, based on resolved occurrences with valid end dates.
+ * Reads the histograms kept by the store, so the cost does not depend on the number of occurrences.
  *
- * @param head Pointer to the head of the occurrence linked list.
+ * @param occurrences Pointer to the occurrence store.
  */
-void reportOperationalEfficiency(OccurrenceNode* head);
+void reportOperationalEfficiency(const OccurrenceStore* occurrences);
+
+/**
+ * @brief Prints the mean and percentiles of a grid of durations, per occurrence type and priority.
+ *
+ * @param grid Pointer to a grid indexed by TYPE_PRIORITY_CELL.
+ */
+void printPercentileTable(const HistogramGrid* grid);
 
 /**
  * @brief COMPLEX REPORT 2: Equipment Usage and Strain Analysis.
  *
  * Analyzes the ratio of equipment in maintenance versus operational status to determine
  * if the fleet is overstrained. Provides strategic advice if the maintenance ratio exceeds 30%.
+ * Reads the per-status counters of the store, so it runs in constant time.
+ *
+ * @param equipments Pointer to the equipment store.
+ */
+void reportEquipmentStrain(const EquipmentStore* equipments);
+
+/**
+ * @brief COMPLEX REPORT 3: Occurrences in a Date Range (e.g. a summer season).
+ *
+ * Counts the active occurrences of the range by type and priority and the average resolution
+ * time of the resolved ones. The range is located with the time index of the store, so the cost
+ * is logarithmic in the history plus the number of occurrences in the range. Long ranges are
+ * split into partitions counted in parallel (see parallel.h).
+ *
+ * @param occurrences Pointer to the occurrence store.
+ * @param from Start of the range (inclusive).
+ * @param to End of the range (inclusive).
+ */
+void reportOccurrencesInRange(const OccurrenceStore* occurrences, Timestamp from, Timestamp to);
+
+/**
+ * @brief COMPLEX REPORT 4: Monthly Trend of a year.
+ *
+ * Lists, month by month, the active occurrences by type, how many were resolved and their average
+ * resolution time. Reads the month cells of the rollup cube, so the cost depends on the number
+ * of cells, not on the number of occurrences.
+ *
+ * @param occurrences Pointer to the occurrence store.
+ * @param year Year to report.
+ */
+void reportMonthlyTrend(const OccurrenceStore* occurrences, int year);
+
+/**
+ * @brief DECISION SUPPORT: Dispatch Recommendation.
+ *
+ * Ranks the available firefighters (specialty matching the occurrence type first, then the least
+ * loaded by totalInterventions) and the operational equipment (matching type first) and keeps as
+ * many as the priority calls for. The candidates come from the availability queues kept by the
+ * stores, so the cost depends only on the size of the recommendation, not on the store sizes.
+ *
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param type Type of the occurrence.
+ * @param priority Priority of the occurrence (LOW 2+1, NORMAL 4+2, HIGH 6+3 firefighters+equipment).
+ * @param result Pointer to the recommendation to fill.
+ */
+void recommendResources(const FirefighterStore* firefighters, const EquipmentStore* equipments,
+                        OccurrenceType type, Priority priority, Recommendation* result);
+
+/**
+ * @brief Displays the dispatch recommendation for an occurrence.
  *
- * @param head Pointer to the head of the equipment linked list.
+ * @param firefighters Pointer to the firefighter store.
+ * @param equipments Pointer to the equipment store.
+ * @param occurrences Pointer to the occurrence store.
+ * @param occurrenceId ID of the occurrence to staff.
  */
-void reportEquipmentStrain(EquipmentNode* head);
+void showRecommendation(const FirefighterStore* firefighters, const EquipmentStore* equipments,
+                        const OccurrenceStore* occurrences, int occurrenceId);
 
 #endif // STATISTICS_H
\ No newline at end of file
@@ -0,0 +1,336 @@
+/**
+ * @file store.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.3
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the helpers shared by the contiguous entity stores.
+ */
+
+#include <stdio.h>   // Provides standard input and output functions (e.g., printf, scanf)
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for string manipulation (e.g., strcpy, strlen)
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STORE_USE_MMAP
+#include <fcntl.h>     // Provides open
+#include <sys/mman.h>  // Provides mmap, munmap
+#include <sys/stat.h>  // Provides fstat
+#include <unistd.h>    // Provides close, pwrite
+#endif
+
+#include "store.h"
+
+#define INITIAL_CAPACITY 16
+
+/**
+ * @brief Header at the start of every entity data file, followed by the records.
+ *
+ * A file is only loaded if its magic, version and record size match the store reading it, so a
+ * file written with another record layout is never reinterpreted.
+ */
+typedef struct {
+    int magic;
+    int version;
+    int recordSize;
+    int count; /**< Records in the file (bytes past them are an interrupted append). */
+} StoreHeader;
+
+/**
+ * @brief Returns the address of the first record of a mapping (just past the header).
+ */
+#define RECORDS_OF(mapping) ((char*) (mapping) + sizeof(StoreHeader))
+
+/**
+ * @brief Returns the start of the mapping holding an array of records.
+ */
+#define MAPPING_OF(records) ((char*) (records) - sizeof(StoreHeader))
+
+/**
+ * @brief Ensures a store array can hold at least the requested number of elements.
+ */
+int storeReserve(void** items, int* capacity, size_t* mappedSize, int needed, size_t elementSize) {
+    int newCapacity;
+    void* grown;
+
+    if (needed <= *capacity) return 1;
+
+    newCapacity = *capacity ? *capacity : INITIAL_CAPACITY;
+    while (newCapacity < needed) newCapacity *= 2;
+
+    if (mappedSize && *mappedSize) {
+        // Leave the mapping: copy the records (including modified pages) to the heap.
+        grown = malloc((size_t) newCapacity * elementSize);
+        if (!grown) return 0;
+        memcpy(grown, *items, (size_t) *capacity * elementSize);
+#ifdef STORE_USE_MMAP
+        munmap(MAPPING_OF(*items), *mappedSize);
+#endif
+        *mappedSize = 0;
+    } else {
+        grown = realloc(*items, (size_t) newCapacity * elementSize);
+        if (!grown) return 0;
+    }
+
+    *items = grown;
+    *capacity = newCapacity;
+    return 1;
+}
+
+/**
+ * @brief Checks that a header describes the expected records and fits in the file.
+ */
+static int validHeader(const StoreHeader* header, int magic, int version, size_t elementSize, long fileSize) {
+    return header->magic == magic && header->version == version && header->recordSize == (int) elementSize &&
+           header->count >= 0 &&
+           (double) header->count * (double) elementSize <= (double) fileSize - (double) sizeof(StoreHeader);
+}
+
+/**
+ * @brief Moves a file that cannot be read aside, so the next save does not overwrite it.
+ */
+static void rejectFile(const char* path) {
+    char oldPath[256];
+    sprintf(oldPath, "%.240s.old", path);
+    remove(oldPath);
+    rename(path, oldPath);
+    fprintf(stderr, "Ficheiro %s inválido ou de outra versão: guardado como %s e ignorado.\n", path, oldPath);
+}
+
+/**
+ * @brief Maps or reads the records of a data file, returning 1, 0 if it is missing or -1 if its header is refused.
+ */
+static int readRecords(const char* path, int magic, int version, void** items, int* count, int* capacity,
+                       size_t* mappedSize, size_t elementSize) {
+    StoreHeader header;
+    FILE* fp;
+    long size;
+
+    *items = NULL;
+    *count = 0;
+    *capacity = 0;
+    *mappedSize = 0;
+
+#ifdef STORE_USE_MMAP
+    {
+        struct stat st;
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return 0;
+        if (fstat(fd, &st) == 0 && pread(fd, &header, sizeof(StoreHeader), 0) == (ssize_t) sizeof(StoreHeader) &&
+            validHeader(&header, magic, version, elementSize, (long) st.st_size)) {
+            size_t length = sizeof(StoreHeader) + (size_t) header.count * elementSize;
+            void* mapping = header.count > 0 ? mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            if (mapping != MAP_FAILED) {
+                close(fd);
+                *items = RECORDS_OF(mapping);
+                *count = header.count;
+                *capacity = header.count;
+                *mappedSize = length;
+                return 1;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    fp = fopen(path, "rb");
+    if (!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (fread(&header, sizeof(StoreHeader), 1, fp) != 1 || !validHeader(&header, magic, version, elementSize, size)) {
+        fclose(fp);
+        return -1;
+    }
+    if (header.count > 0 && storeReserve(items, capacity, mappedSize, header.count, elementSize)) {
+        *count = (int) fread(*items, elementSize, header.count, fp);
+    }
+    fclose(fp);
+    return 1;
+}
+
+/**
+ * @brief Loads a file of fixed-size records into a store array.
+ */
+int storeLoad(const char* path, int magic, int version, void** items, int* count, int* capacity,
+              size_t* mappedSize, size_t elementSize, int (*validRecord)(const void* record)) {
+    int i, loaded = readRecords(path, magic, version, items, count, capacity, mappedSize, elementSize);
+
+    // One bad record means the file cannot be trusted: refuse it whole.
+    for (i = 0; loaded == 1 && validRecord && i < *count; i++) {
+        if (!validRecord((const char*) *items + (size_t) i * elementSize)) {
+            storeRelease(items, count, capacity, mappedSize);
+            loaded = -1;
+        }
+    }
+    if (loaded < 0) rejectFile(path);
+    return loaded == 1;
+}
+
+/**
+ * @brief Writes an optional header and an array to a temporary file, then renames it over the original.
+ */
+static int writeFile(const char* path, const StoreHeader* header, const void* items, int count, size_t elementSize) {
+    char tmpPath[256];
+    FILE* fp;
+    int ok;
+
+    sprintf(tmpPath, "%.240s.tmp", path);
+    fp = fopen(tmpPath, "wb");
+    if (!fp) return 0;
+    ok = !header || fwrite(header, sizeof(StoreHeader), 1, fp) == 1;
+    ok = ok && (count == 0 || fwrite(items, elementSize, count, fp) == (size_t) count);
+    if (fclose(fp) != 0) ok = 0;
+
+    if (ok && rename(tmpPath, path) != 0) {
+        // Some platforms refuse to rename over an existing file.
+        remove(path);
+        ok = rename(tmpPath, path) == 0;
+    }
+    if (!ok) remove(tmpPath);
+    return ok;
+}
+
+/**
+ * @brief Writes a store array to a binary file (through a temporary file).
+ */
+int storeSave(const char* path, const void* items, int count, size_t elementSize) {
+    return writeFile(path, NULL, items, count, elementSize);
+}
+
+/**
+ * @brief Flags a persisted record as modified.
+ */
+void storeMarkDirty(unsigned char* dirty, int persistedCount, int slot) {
+    if (slot >= 0 && slot < persistedCount) dirty[slot] = 1;
+}
+
+/**
+ * @brief Writes bytes at a position in the file.
+ */
+#ifdef STORE_USE_MMAP
+static int writeAt(int fd, const char* data, size_t length, off_t offset) {
+    while (length > 0) {
+        ssize_t written = pwrite(fd, data, length, offset);
+        if (written <= 0) return 0;
+        data += written;
+        offset += written;
+        length -= (size_t) written;
+    }
+    return 1;
+}
+
+static int readHeader(int fd, StoreHeader* header) {
+    return pread(fd, header, sizeof(StoreHeader), 0) == (ssize_t) sizeof(StoreHeader);
+}
+#else
+static int writeAt(FILE* fp, const char* data, size_t length, long offset) {
+    if (fseek(fp, offset, SEEK_SET) != 0) return 0;
+    return fwrite(data, 1, length, fp) == length;
+}
+
+static int readHeader(FILE* fp, StoreHeader* header) {
+    return fseek(fp, 0, SEEK_SET) == 0 && fread(header, sizeof(StoreHeader), 1, fp) == 1;
+}
+#endif
+
+/**
+ * @brief Writes a run of records at their position in the file (just past the header).
+ */
+#ifdef STORE_USE_MMAP
+static int writeRecords(int fd, const char* items, int first, int n, size_t elementSize) {
+    return writeAt(fd, items + (size_t) first * elementSize, (size_t) n * elementSize,
+                   (off_t) sizeof(StoreHeader) + (off_t) first * (off_t) elementSize);
+}
+#else
+static int writeRecords(FILE* fp, const char* items, int first, int n, size_t elementSize) {
+    return writeAt(fp, items + (size_t) first * elementSize, (size_t) n * elementSize,
+                   (long) (sizeof(StoreHeader) + (size_t) first * elementSize));
+}
+#endif
+
+/**
+ * @brief Writes the changes of a store array to its binary file.
+ */
+int storeFlush(const char* path, int magic, int version, const void* items, int count, size_t elementSize,
+               unsigned char** dirty, int* persistedCount) {
+    int ok = 1;
+    int i, run;
+    long fileSize = -1;
+    unsigned char* flags;
+    StoreHeader header, current;
+
+#ifdef STORE_USE_MMAP
+    struct stat st;
+    int fd = open(path, O_RDWR);
+    if (fd >= 0 && fstat(fd, &st) == 0) fileSize = (long) st.st_size;
+#else
+    FILE* fd = fopen(path, "r+b");
+    if (fd) {
+        fseek(fd, 0, SEEK_END);
+        fileSize = ftell(fd);
+    }
+#endif
+
+    header.magic = magic;
+    header.version = version;
+    header.recordSize = (int) elementSize;
+    header.count = count;
+
+    // In-place writes are only safe on the very file that was loaded or last written.
+    if (*persistedCount == 0 || fileSize != (long) (sizeof(StoreHeader) + (size_t) *persistedCount * elementSize) ||
+        !readHeader(fd, &current) || current.magic != magic || current.version != version ||
+        current.recordSize != (int) elementSize || current.count != *persistedCount) {
+        // Nothing reliable on disk: write the whole array.
+#ifdef STORE_USE_MMAP
+        if (fd >= 0) close(fd);
+#else
+        if (fd) fclose(fd);
+#endif
+        ok = writeFile(path, &header, items, count, elementSize);
+    } else {
+        // Rewrite runs of consecutive dirty records, then append the new ones and count them in the header.
+        for (i = 0; ok && i < *persistedCount; i++) {
+            if (!(*dirty)[i]) continue;
+            for (run = i; run < *persistedCount && (*dirty)[run]; run++);
+            ok = writeRecords(fd, (const char*) items, i, run - i, elementSize);
+            i = run;
+        }
+        if (ok && count > *persistedCount) {
+            ok = writeRecords(fd, (const char*) items, *persistedCount, count - *persistedCount, elementSize) &&
+                 writeAt(fd, (const char*) &header, sizeof(StoreHeader), 0);
+        }
+#ifdef STORE_USE_MMAP
+        if (close(fd) != 0) ok = 0;
+#else
+        if (fclose(fd) != 0) ok = 0;
+#endif
+    }
+    if (!ok) return 0;
+
+    flags = (unsigned char*) realloc(*dirty, count > 0 ? (size_t) count : 1);
+    if (!flags) return 0;
+    memset(flags, 0, count > 0 ? (size_t) count : 1);
+    *dirty = flags;
+    *persistedCount = count;
+    return 1;
+}
+
+/**
+ * @brief Releases a store array, unmapping it or freeing it as appropriate.
+ */
+void storeRelease(void** items, int* count, int* capacity, size_t* mappedSize) {
+#ifdef STORE_USE_MMAP
+    if (*mappedSize) munmap(MAPPING_OF(*items), *mappedSize);
+    else free(*items);
+#else
+    free(*items);
+#endif
+    *items = NULL;
+    *count = 0;
+    *capacity = 0;
+    *mappedSize = 0;
+}
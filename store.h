@@ -0,0 +1,120 @@
+/**
+ * @file store.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.3
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the helpers shared by the contiguous entity stores (growth, loading and saving).
+ *
+ * On POSIX systems the data files are memory-mapped privately (MAP_PRIVATE): reads are served
+ * directly from the page cache and every modified record is copied on write by the kernel,
+ * so the file on disk only changes when the store is saved.
+ *
+ * Every data file starts with a header holding a magic number, a layout version, the record size and
+ * the record count; a file whose header does not match the store reading it is never loaded. Records
+ * keep the order of the file, so the file offset of a record is the header size plus its slot times
+ * the record size. Saving only rewrites the records flagged as dirty (in place) and appends the new ones.
+ */
+
+#ifndef STORE_H
+#define STORE_H
+
+#include <stddef.h> // Provides size_t
+
+/**
+ * @brief Ensures a store array can hold at least the requested number of elements.
+ *
+ * The capacity grows geometrically (doubling), so appending one element at a time
+ * costs amortized O(1). A memory-mapped array is moved to the heap the first time it grows.
+ *
+ * @param items Pointer to the array pointer (may be reallocated).
+ * @param capacity Pointer to the current capacity (in elements).
+ * @param mappedSize Pointer to the size of the file mapping backing the array (0 if heap-allocated),
+ *                   or NULL for arrays that are never mapped.
+ * @param needed Minimum number of elements the array must hold.
+ * @param elementSize Size of each element in bytes.
+ * @return Returns 1 on success, 0 if memory could not be allocated.
+ */
+int storeReserve(void** items, int* capacity, size_t* mappedSize, int needed, size_t elementSize);
+
+/**
+ * @brief Loads a file of fixed-size records into a store array.
+ *
+ * Uses a private memory mapping when available (zero-copy), otherwise a single fread. A file whose
+ * header is missing, names another magic or version, counts more records than it holds, or that holds
+ * a record refused by validRecord is renamed to "<path>.old" (so the next save does not overwrite it)
+ * and the store starts empty.
+ *
+ * @param path Path of the binary file.
+ * @param magic Magic number identifying the kind of records.
+ * @param version Version of the record layout.
+ * @param items Pointer to receive the array.
+ * @param count Pointer to receive the number of records.
+ * @param capacity Pointer to receive the capacity of the array.
+ * @param mappedSize Pointer to receive the size of the mapping (0 if the records were read to the heap).
+ * @param elementSize Size of each record in bytes.
+ * @param validRecord Function returning 0 for a record that cannot be used (e.g. a status out of range), or NULL.
+ * @return Returns 1 if the file was loaded, 0 if it does not exist, could not be read or was refused.
+ */
+int storeLoad(const char* path, int magic, int version, void** items, int* count, int* capacity,
+              size_t* mappedSize, size_t elementSize, int (*validRecord)(const void* record));
+
+/**
+ * @brief Writes an array to a binary file, as is (no header).
+ *
+ * The records are written to a temporary file which then replaces the original, so a mapping
+ * of the previous file is never truncated underneath the store.
+ *
+ * @param path Path of the binary file.
+ * @param items Array of records.
+ * @param count Number of records.
+ * @param elementSize Size of each record in bytes.
+ * @return Returns 1 on success, 0 on failure (the original file is left untouched).
+ */
+int storeSave(const char* path, const void* items, int count, size_t elementSize);
+
+/**
+ * @brief Flags a persisted record as modified so the next flush rewrites it in place.
+ *
+ * Records that are not in the file yet (slot >= persistedCount) are always appended, so they are ignored.
+ *
+ * @param dirty Array of dirty flags (one per persisted record).
+ * @param persistedCount Number of records already in the file.
+ * @param slot Position of the modified record.
+ */
+void storeMarkDirty(unsigned char* dirty, int persistedCount, int slot);
+
+/**
+ * @brief Writes the changes of a store array to its binary file.
+ *
+ * Dirty records are written in place with positional writes (consecutive dirty records are
+ * written together), records beyond persistedCount are appended and the header count updated. If
+ * the file does not match the persisted records (missing, other header or size) the whole array
+ * is written instead, after a new header.
+ *
+ * @param path Path of the binary file.
+ * @param magic Magic number identifying the kind of records.
+ * @param version Version of the record layout.
+ * @param items Array of records.
+ * @param count Number of records.
+ * @param elementSize Size of each record in bytes.
+ * @param dirty Pointer to the array of dirty flags (resized to count and cleared on success).
+ * @param persistedCount Pointer to the number of records in the file (set to count on success).
+ * @return Returns 1 on success, 0 on failure.
+ */
+int storeFlush(const char* path, int magic, int version, const void* items, int count, size_t elementSize,
+               unsigned char** dirty, int* persistedCount);
+
+/**
+ * @brief Releases a store array, unmapping it or freeing it as appropriate.
+ *
+ * @param items Pointer to the array pointer (set to NULL).
+ * @param count Pointer to the number of records (set to 0).
+ * @param capacity Pointer to the capacity (set to 0).
+ * @param mappedSize Pointer to the size of the mapping (set to 0).
+ */
+void storeRelease(void** items, int* count, int* capacity, size_t* mappedSize);
+
+#endif // STORE_H
@@ -0,0 +1,222 @@
+/**
+ * @file symbols.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the string interning table.
+ */
+
+#include <stdio.h>   // Provides standard input and output functions (e.g., printf, scanf)
+#include <stdlib.h>  // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>  // Provides functions for string manipulation (e.g., strcpy, strlen)
+
+#include "symbols.h"
+#include "journal.h"
+#include "store.h"
+
+/**
+ * @brief The interning table: texts packed in one buffer, located by offset, found by hash.
+ */
+static struct {
+    char* text;         /**< All texts, each followed by its terminating '\0'. */
+    size_t textSize;
+    size_t textCapacity;
+    int* offsets;       /**< Offset of each symbol's text in the buffer. */
+    int count;
+    int capacity;
+    int* table;         /**< Open addressing hash table of symbols (-1 = empty). */
+    int tableSize;
+    int persistedCount; /**< Symbols already in the file. */
+    long persistedBytes;
+} symbols;
+
+/**
+ * @brief FNV-1a hash of a text.
+ */
+static unsigned int hashText(const char* text) {
+    unsigned int hash = 2166136261u;
+    while (*text) {
+        hash ^= (unsigned char) *text++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds the table position of a text (either its symbol or the empty slot where it belongs).
+ */
+static int probe(const char* text) {
+    unsigned int mask = (unsigned int) symbols.tableSize - 1;
+    unsigned int pos = hashText(text) & mask;
+    while (symbols.table[pos] >= 0 && strcmp(symbols.text + symbols.offsets[symbols.table[pos]], text) != 0) {
+        pos = (pos + 1) & mask;
+    }
+    return (int) pos;
+}
+
+/**
+ * @brief Doubles the hash table and reinserts every symbol.
+ */
+static int growTable(void) {
+    int newSize = symbols.tableSize ? symbols.tableSize * 2 : 256;
+    int* newTable = (int*) malloc(sizeof(int) * newSize);
+    int* oldTable = symbols.table;
+    int i;
+    if (!newTable) return 0;
+
+    for (i = 0; i < newSize; i++) newTable[i] = -1;
+    symbols.table = newTable;
+    symbols.tableSize = newSize;
+    for (i = 0; i < symbols.count; i++) {
+        symbols.table[probe(symbols.text + symbols.offsets[i])] = i;
+    }
+    free(oldTable);
+    return 1;
+}
+
+/**
+ * @brief Adds a text that is not yet in the table.
+ */
+static Symbol addSymbol(const char* text, size_t length) {
+    Symbol symbol = symbols.count;
+
+    if ((symbols.count + 1) * 2 > symbols.tableSize && !growTable()) return -1;
+    if (!storeReserve((void**) &symbols.offsets, &symbols.capacity, NULL, symbols.count + 1, sizeof(int))) return -1;
+    if (symbols.textSize + length + 1 > symbols.textCapacity) {
+        size_t newCapacity = symbols.textCapacity ? symbols.textCapacity : 4096;
+        char* grown;
+        while (newCapacity < symbols.textSize + length + 1) newCapacity *= 2;
+        grown = (char*) realloc(symbols.text, newCapacity);
+        if (!grown) return -1;
+        symbols.text = grown;
+        symbols.textCapacity = newCapacity;
+    }
+
+    memcpy(symbols.text + symbols.textSize, text, length);
+    symbols.text[symbols.textSize + length] = '\0';
+    symbols.offsets[symbol] = (int) symbols.textSize;
+    symbols.textSize += length + 1;
+    symbols.count++;
+    symbols.table[probe(symbols.text + symbols.offsets[symbol])] = symbol;
+    return symbol;
+}
+
+/**
+ * @brief Returns the symbol of a text, adding (and journaling) it if it is new.
+ */
+Symbol internString(const char* text) {
+    char bounded[MAX_STRING];
+    Symbol symbol;
+    size_t length = strlen(text);
+
+    if (length >= MAX_STRING) {
+        length = MAX_STRING - 1;
+        memcpy(bounded, text, length);
+        bounded[length] = '\0';
+        text = bounded;
+    }
+
+    symbol = findSymbol(text);
+    if (symbol >= 0) return symbol;
+
+    symbol = addSymbol(text, length);
+    if (symbol >= 0) journalAppend(JOURNAL_SYMBOL, text, (int) length + 1);
+    return symbol;
+}
+
+/**
+ * @brief Returns the symbol of a text without adding it.
+ */
+Symbol findSymbol(const char* text) {
+    int pos;
+    if (symbols.tableSize == 0) return -1;
+    pos = probe(text);
+    return symbols.table[pos];
+}
+
+/**
+ * @brief Returns the text of a symbol.
+ */
+const char* symbolText(Symbol symbol) {
+    if (symbol < 0 || symbol >= symbols.count) return "";
+    return symbols.text + symbols.offsets[symbol];
+}
+
+/**
+ * @brief Returns the number of symbols in the table.
+ */
+int symbolCount(void) {
+    return symbols.count;
+}
+
+/**
+ * @brief Loads the symbol table from its binary file.
+ *
+ * The file is a sequence of (int length, length characters) entries, in symbol order.
+ */
+int loadSymbols(void) {
+    FILE* fp = fopen(FILE_SYMBOLS, "rb");
+    char text[MAX_STRING];
+    int length;
+    long bytes = 0;
+
+    if (!fp) return 0;
+    while (fread(&length, sizeof(int), 1, fp) == 1) {
+        if (length < 0 || length >= MAX_STRING || fread(text, 1, length, fp) != (size_t) length) break;
+        if (addSymbol(text, (size_t) length) < 0) break;
+        bytes += (long) sizeof(int) + length;
+    }
+    fclose(fp);
+
+    symbols.persistedCount = symbols.count;
+    symbols.persistedBytes = bytes;
+    return 1;
+}
+
+/**
+ * @brief Appends the symbols created since the last save to the binary file.
+ */
+int saveSymbols(void) {
+    FILE* fp = fopen(FILE_SYMBOLS, "ab");
+    int first = symbols.persistedCount;
+    long bytes = symbols.persistedBytes;
+    int ok = 1;
+    int i;
+
+    if (!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    if (ftell(fp) != bytes) {
+        // The file does not hold what was loaded: rewrite it from the first symbol.
+        fclose(fp);
+        fp = fopen(FILE_SYMBOLS, "wb");
+        if (!fp) return 0;
+        first = 0;
+        bytes = 0;
+    }
+
+    for (i = first; ok && i < symbols.count; i++) {
+        const char* text = symbols.text + symbols.offsets[i];
+        int length = (int) strlen(text);
+        ok = fwrite(&length, sizeof(int), 1, fp) == 1 && fwrite(text, 1, length, fp) == (size_t) length;
+        bytes += (long) sizeof(int) + length;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    if (!ok) return 0;
+
+    symbols.persistedCount = symbols.count;
+    symbols.persistedBytes = bytes;
+    return 1;
+}
+
+/**
+ * @brief Frees all memory used by the symbol table.
+ */
+void freeSymbols(void) {
+    free(symbols.text);
+    free(symbols.offsets);
+    free(symbols.table);
+    memset(&symbols, 0, sizeof(symbols));
+}
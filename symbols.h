@@ -0,0 +1,71 @@
+/**
+ * @file symbols.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the string interning table used by the text fields of every entity.
+ *
+ * Each distinct text (location, name, specialty, ...) is stored once and records keep its
+ * 32-bit Symbol, both in memory and on disk. Two texts are equal exactly when their symbols are,
+ * so comparisons become integer comparisons. The table is persisted append-only in strings.bin.
+ */
+
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include "data.h"
+
+/**
+ * @brief Returns the symbol of a text, adding it to the table if it is new.
+ *
+ * New symbols are journaled before being returned, so records that reference them can be replayed.
+ *
+ * @param text Text to intern (truncated to MAX_STRING - 1 characters).
+ * @return Returns the symbol, or -1 if memory could not be allocated.
+ */
+Symbol internString(const char* text);
+
+/**
+ * @brief Returns the symbol of a text without adding it.
+ *
+ * @param text Text to search for.
+ * @return Returns the symbol, or -1 if the text was never interned.
+ */
+Symbol findSymbol(const char* text);
+
+/**
+ * @brief Returns the text of a symbol.
+ *
+ * @param symbol Symbol to resolve.
+ * @return Returns the text, or an empty string for an unknown symbol.
+ */
+const char* symbolText(Symbol symbol);
+
+/**
+ * @brief Returns the number of symbols in the table.
+ */
+int symbolCount(void);
+
+/**
+ * @brief Loads the symbol table from its binary file.
+ *
+ * @return Returns 1 if the file was loaded, 0 if it does not exist.
+ */
+int loadSymbols(void);
+
+/**
+ * @brief Appends the symbols created since the last save to the binary file.
+ *
+ * @return Returns 1 on success, 0 if the file could not be written.
+ */
+int saveSymbols(void);
+
+/**
+ * @brief Frees all memory used by the symbol table.
+ */
+void freeSymbols(void);
+
+#endif // SYMBOLS_H
@@ -0,0 +1,284 @@
+/**
+ * @file tail.c
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Implementation of the streaming ingest mode.
+ */
+
+#include <stdio.h>     // Provides standard input and output functions (e.g., fprintf)
+#include <stdlib.h>    // Provides functions for memory allocation, process control, conversions, etc.
+#include <string.h>    // Provides functions for memory manipulation (e.g., memchr, memmove)
+#include <errno.h>     // Provides errno (e.g., EINTR)
+#include <signal.h>    // Provides sigaction
+#include <time.h>      // Provides nanosleep
+#include <fcntl.h>     // Provides open
+#include <unistd.h>    // Provides read, lseek, pread, pwrite and close
+#include <sys/types.h> // Provides off_t
+#include <sys/stat.h>  // Provides stat, fstat and S_ISFIFO
+
+#include "tail.h"
+#include "ingest.h"
+#include "journal.h"
+
+#define POLL_MILLISECONDS 200
+
+/**
+ * @brief Where to resume a regular file (contents of FILE_TAIL).
+ */
+typedef struct {
+    unsigned long device;
+    unsigned long inode;
+    off_t offset; /**< Just past the line of the last report applied. */
+} TailPosition;
+
+/**
+ * @brief State shared by the reader and the batch hook of the applier.
+ */
+typedef struct {
+    FirefighterStore* firefighters;
+    OccurrenceStore* occurrences;
+    EquipmentStore* equipments;
+    InterventionStore* interventions;
+    IngestQueue* queue;
+    TailPosition* lineEnds; /**< File and offset after the line of each queued report, by queue position. */
+    unsigned long lineEndMask;
+    unsigned long submitted; /**< Reports queued so far (their queue positions are 0 to submitted - 1). */
+    unsigned long recorded; /**< Reports applied when the position was last written. */
+    int positionFd; /**< FILE_TAIL, or -1 when following a pipe (nothing to resume). */
+} TailState;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+/**
+ * @brief Signal handler: asks the reader to stop.
+ */
+static void requestStop(int signal) {
+    (void) signal;
+    stopRequested = 1;
+}
+
+/**
+ * @brief Sleeps for some milliseconds (interrupted by the stop signals).
+ */
+static void pauseFor(long milliseconds) {
+    struct timespec pause;
+    pause.tv_sec = milliseconds / 1000;
+    pause.tv_nsec = (milliseconds % 1000) * 1000000L;
+    nanosleep(&pause, NULL);
+}
+
+/**
+ * @brief After each batch of the applier (the only writer): records how far the file was applied
+ * and checkpoints the journal when it is due.
+ *
+ * The reports of the batch are already journaled, so the saved position never runs ahead of the
+ * store; a crash repeats at most the reports of the batch being applied.
+ */
+static void afterBatch(void* context, int acquire) {
+    TailState* state = (TailState*) context;
+    unsigned long consumed;
+
+    if (acquire) return;
+    consumed = state->queue->ring.head;
+    if (state->positionFd >= 0 && consumed != state->recorded) {
+        const TailPosition* position = &state->lineEnds[(consumed - 1) & state->lineEndMask];
+        if (pwrite(state->positionFd, position, sizeof(TailPosition), 0) == (ssize_t) sizeof(TailPosition)) {
+            state->recorded = consumed;
+        }
+    }
+    if (journalPending() >= JOURNAL_CHECKPOINT_ENTRIES) {
+        journalCheckpoint(state->firefighters, state->occurrences, state->equipments, state->interventions);
+    }
+}
+
+/**
+ * @brief Parses a complete line (already terminated in place) and queues it, waiting while the queue is full.
+ */
+static void submitLine(TailState* state, char* line, char* end, const TailPosition* file, off_t lineEnd,
+                       unsigned long* invalid) {
+    IngestRecord record;
+    if (end > line && end[-1] == '\r') *--end = '\0';
+    if (line == end || line[0] == '#') return;
+    if (!ingestParse(line, &record)) {
+        (*invalid)++;
+        return;
+    }
+    // Published with the report: the applier reads it once the report is consumed.
+    state->lineEnds[state->submitted & state->lineEndMask] = *file;
+    state->lineEnds[state->submitted & state->lineEndMask].offset = lineEnd;
+    // Backpressure: stop reading until the applier makes room.
+    while (!ingestSubmit(state->queue, &record)) pauseFor(1);
+    state->submitted++;
+}
+
+/**
+ * @brief Fills the identity of the open file (device and inode) for the positions of its lines.
+ */
+static void identifyFile(int fd, TailPosition* file) {
+    struct stat info;
+    memset(file, 0, sizeof(TailPosition));
+    if (fstat(fd, &info) == 0) {
+        file->device = (unsigned long) info.st_dev;
+        file->inode = (unsigned long) info.st_ino;
+    }
+}
+
+/**
+ * @brief Opens FILE_TAIL and returns where to resume the file (0 if it is another file or was truncated).
+ */
+static off_t resumePosition(TailState* state, int fd, const TailPosition* file) {
+    struct stat info;
+    TailPosition saved;
+
+    state->positionFd = -1;
+    if (fstat(fd, &info) != 0 || S_ISFIFO(info.st_mode)) return 0;
+    state->positionFd = open(FILE_TAIL, O_RDWR | O_CREAT, 0644);
+    if (state->positionFd < 0) return 0;
+    if (pread(state->positionFd, &saved, sizeof(TailPosition), 0) != (ssize_t) sizeof(TailPosition)) return 0;
+    if (saved.device != file->device || saved.inode != file->inode) return 0;
+    if (saved.offset < 0 || saved.offset > info.st_size) return 0;
+    return saved.offset;
+}
+
+/**
+ * @brief Tells whether the path now names another file than the one open (a log rotated by rename).
+ */
+static int fileReplaced(const char* path, const TailPosition* file) {
+    struct stat info;
+    if (stat(path, &info) != 0) return 0; // Not recreated yet: keep waiting on the old one.
+    return (unsigned long) info.st_dev != file->device || (unsigned long) info.st_ino != file->inode;
+}
+
+/**
+ * @brief Follows a file or named pipe, adding every report to the store.
+ */
+int runTail(const char* path, FirefighterStore* firefighters, OccurrenceStore* occurrences, int* idOccurrence,
+            EquipmentStore* equipments, InterventionStore* interventions) {
+    TailState state;
+    TailPosition file;
+    IngestQueue queue;
+    struct sigaction action;
+    struct stat info;
+    char* buffer;
+    size_t used = 0;
+    off_t offset = 0;
+    unsigned long lines = 0, invalid = 0;
+    int discarding = 0;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) return 0;
+    buffer = (char*) malloc(TAIL_BUFFER);
+    memset(&state, 0, sizeof(TailState));
+    state.firefighters = firefighters;
+    state.occurrences = occurrences;
+    state.equipments = equipments;
+    state.interventions = interventions;
+    state.queue = &queue;
+    if (!buffer || !ingestStart(&queue, TAIL_QUEUE_CAPACITY, occurrences, idOccurrence, afterBatch, &state)) {
+        free(buffer);
+        close(fd);
+        return 0;
+    }
+    // A report is consumed before the one a queue length later is queued, so two lengths of
+    // offsets keep the entry of every report in the batch being applied.
+    state.lineEndMask = 2 * queue.ring.mask + 1;
+    state.lineEnds = (TailPosition*) malloc(sizeof(TailPosition) * (state.lineEndMask + 1));
+    if (!state.lineEnds) {
+        ingestStop(&queue);
+        free(buffer);
+        close(fd);
+        return 0;
+    }
+    identifyFile(fd, &file);
+    offset = resumePosition(&state, fd, &file);
+    if (offset > 0) lseek(fd, offset, SEEK_SET);
+
+    // No SA_RESTART: the signal interrupts a blocking read or open of the pipe.
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    stopRequested = 0;
+
+    if (offset > 0) fprintf(stderr, "A seguir %s a partir do byte %ld.\n", path, (long) offset);
+    else fprintf(stderr, "A seguir %s.\n", path);
+    while (!stopRequested) {
+        ssize_t n = read(fd, buffer + used, TAIL_BUFFER - used);
+        char* line;
+        char* newline;
+        char* end;
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (n == 0) {
+            if (fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode)) {
+                // Every writer closed the pipe: wait for the next one.
+                close(fd);
+                fd = open(path, O_RDONLY);
+                if (fd < 0) break;
+                continue;
+            }
+            if (fileReplaced(path, &file)) {
+                // The log was rotated by rename: everything of the old one is read, follow the new one.
+                int next = open(path, O_RDONLY);
+                if (next >= 0) {
+                    close(fd);
+                    fd = next;
+                    identifyFile(fd, &file);
+                    offset = 0;
+                    used = 0;
+                    discarding = 0;
+                    fprintf(stderr, "A seguir o novo %s.\n", path);
+                    continue;
+                }
+            }
+            if (fstat(fd, &info) == 0 && info.st_size < offset) {
+                // The log was truncated (rotated in place): start over.
+                lseek(fd, 0, SEEK_SET);
+                offset = 0;
+                used = 0;
+                continue;
+            }
+            pauseFor(POLL_MILLISECONDS);
+            continue;
+        }
+        offset += n;
+        used += (size_t) n;
+
+        // Split the complete lines in place; only the unfinished last one is kept for the next read.
+        line = buffer;
+        end = buffer + used;
+        while ((newline = (char*) memchr(line, '\n', (size_t) (end - line))) != NULL) {
+            *newline = '\0';
+            if (discarding) discarding = 0;
+            else submitLine(&state, line, newline, &file, offset - (off_t) (end - (newline + 1)), &invalid);
+            lines++;
+            line = newline + 1;
+        }
+        used = (size_t) (end - line);
+        if (used == TAIL_BUFFER) {
+            // A line longer than the buffer: drop it up to its end.
+            if (!discarding) invalid++;
+            discarding = 1;
+            used = 0;
+        } else if (used > 0 && line != buffer) {
+            memmove(buffer, line, used);
+        }
+    }
+
+    close(fd);
+    ingestStop(&queue);
+    if (state.positionFd >= 0) close(state.positionFd);
+    free(state.lineEnds);
+    free(buffer);
+    fprintf(stderr, "%lu linha(s) lida(s), %lu ocorrência(s) registada(s), %lu inválida(s).\n",
+            lines, queue.applied, invalid);
+    return 1;
+}
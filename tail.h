@@ -0,0 +1,53 @@
+/**
+ * @file tail.h
+ * @author Afonso Mendes
+ * @author Rodrigo Ferreira
+ * @version 1.0
+ *
+ * @copyright Copyright (C) ESTG 2025. All Rights MIT Licensed.
+ *
+ * @brief Declares the streaming ingest mode: follows a growing log file or a named pipe.
+ *
+ * Each line is an occurrence report "location;type;priority;dd/mm/yyyy hh:mm" (the format of
+ * ingest.h). Lines are parsed in place in a fixed read buffer, so no line is copied, and pushed
+ * into the ingest queue. When the queue is full the reader stops reading until the applier
+ * catches up, so memory stays bounded however fast the stream grows.
+ */
+
+#ifndef TAIL_H
+#define TAIL_H
+
+#include "data.h"
+
+/**
+ * @brief Size of the read buffer (also the longest line accepted).
+ */
+#define TAIL_BUFFER 65536
+
+/**
+ * @brief Slots of the ingest queue used while following a stream.
+ */
+#define TAIL_QUEUE_CAPACITY 4096
+
+/**
+ * @brief Follows a file or named pipe until SIGINT or SIGTERM, adding every report to the store.
+ *
+ * A regular file is polled for new lines, starting over if it is truncated and switching to the new
+ * file once the path names another one (a log rotated by rename). After every batch of
+ * reports applied, the position reached is saved in FILE_TAIL with the identity of the file, so
+ * the next run on the same file resumes there instead of adding its reports again. A named pipe
+ * is reopened whenever its writer closes it. The journal is checkpointed every
+ * JOURNAL_CHECKPOINT_ENTRIES reports; the caller saves and frees the stores.
+ *
+ * @param path Path of the file or named pipe.
+ * @param firefighters Pointer to the firefighter store (saved at checkpoints).
+ * @param occurrences Pointer to the occurrence store receiving the reports.
+ * @param idOccurrence Pointer to the occurrence ID counter.
+ * @param equipments Pointer to the equipment store (saved at checkpoints).
+ * @param interventions Pointer to the intervention store (saved at checkpoints).
+ * @return Returns 1 after a clean stop, 0 if the file could not be opened.
+ */
+int runTail(const char* path, FirefighterStore* firefighters, OccurrenceStore* occurrences, int* idOccurrence,
+            EquipmentStore* equipments, InterventionStore* interventions);
+
+#endif // TAIL_H